@@ -42,16 +42,20 @@ async function populateBoardInfo() {
             // Save current values in memory
             currentValues = {
                 brightness: boardInfo.displaySettings.brightness || "150",
+                autoBrightness: boardInfo.displaySettings.autoBrightness || false,
+                nightBrightness: boardInfo.displaySettings.nightBrightness || 40,
                 wifiMode: boardInfo.displaySettings.wifiMode || "WIFI_STA",
                 ssid: boardInfo.displaySettings.ssid || "v1display",
                 password: boardInfo.displaySettings.password || "password123",
                 disableBLE: boardInfo.displaySettings.disableBLE || false,
                 proxyBLE: boardInfo.displaySettings.proxyBLE || false,
+                proxyBatch: boardInfo.displaySettings.proxyBatch || false,
                 useV1LE: boardInfo.displaySettings.useV1LE || false,
                 timezone: boardInfo.displaySettings.timezone || "UTC",
                 enableGPS: boardInfo.displaySettings.enableGPS || false,
                 lowSpeedThreshold: boardInfo.displaySettings.lowSpeedThreshold || 35,
                 displayOrientation: boardInfo.displaySettings.displayOrientation || 0,
+                displayBufferMode: boardInfo.displaySettings.displayBufferMode || 0,
                 textColor: boardInfo.displaySettings.textColor || "#FF0000",
                 useDefaultV1Mode: boardInfo.displaySettings.useDefaultV1Mode || false,
                 turnOffDisplay: boardInfo.displaySettings.turnOffDisplay || false,
@@ -84,16 +88,20 @@ async function populateBoardInfo() {
 
             // Populate the form fields with current values
             document.getElementById("brightness").value = currentValues.brightness;
+            document.getElementById("autoBrightness").value = currentValues.autoBrightness.toString();
+            document.getElementById("nightBrightness").value = currentValues.nightBrightness;
             document.getElementById("wifiMode").value = currentValues.wifiMode;
             document.getElementById("localSSID").value = currentValues.ssid;
             document.getElementById("localPW").value = currentValues.password;
             document.getElementById("disableBLE").value = currentValues.disableBLE.toString();
             document.getElementById("proxyBLE").value = currentValues.proxyBLE.toString();
+            document.getElementById("proxyBatch").value = currentValues.proxyBatch.toString();
             document.getElementById("useV1LE").value = currentValues.useV1LE.toString();
             document.getElementById("timezone").value = currentValues.timezone;
             document.getElementById("enableGPS").value = currentValues.enableGPS.toString();
             document.getElementById("lowSpeedThreshold").value = currentValues.lowSpeedThreshold;
             document.getElementById("displayOrientation").value = currentValues.displayOrientation;
+            document.getElementById("displayBufferMode").value = currentValues.displayBufferMode;
             document.getElementById("colorPicker").value = currentValues.textColor;
             document.getElementById("useDefaultV1Mode").value = currentValues.useDefaultV1Mode;
             document.getElementById("turnOffDisplay").value = currentValues.turnOffDisplay.toString();
@@ -123,6 +131,13 @@ document.getElementById("settingsForm").addEventListener("submit", function(even
         if (formData.get("brightness") !== currentValues.brightness) {
             updatedSettings.brightness = formData.get("brightness");
         }
+        if ((document.getElementById("autoBrightness").value === "true") !== currentValues.autoBrightness) {
+            updatedSettings.autoBrightness = document.getElementById("autoBrightness").value === "true";
+        }
+        const nightBrightness = parseInt(formData.get("nightBrightness"));
+        if (!isNaN(nightBrightness) && nightBrightness !== currentValues.nightBrightness) {
+            updatedSettings.nightBrightness = nightBrightness;
+        }
         if (formData.get("wifiMode") !== currentValues.wifiMode) {
             updatedSettings.wifiMode = formData.get("wifiMode");
         }
@@ -138,6 +153,9 @@ document.getElementById("settingsForm").addEventListener("submit", function(even
         if ((document.getElementById("proxyBLE").value === "true") !== currentValues.proxyBLE) {
             updatedSettings.proxyBLE = document.getElementById("proxyBLE").value === "true";
         }
+        if ((document.getElementById("proxyBatch").value === "true") !== currentValues.proxyBatch) {
+            updatedSettings.proxyBatch = document.getElementById("proxyBatch").value === "true";
+        }
         if ((document.getElementById("useV1LE").value === "true") !== currentValues.useV1LE) {
             updatedSettings.useV1LE = document.getElementById("useV1LE").value === "true";
         }
@@ -153,6 +171,9 @@ document.getElementById("settingsForm").addEventListener("submit", function(even
         if (parseInt(formData.get("displayOrientation")) !== currentValues.displayOrientation) {
             updatedSettings.displayOrientation = parseInt(formData.get("displayOrientation"));
         }
+        if (parseInt(formData.get("displayBufferMode")) !== currentValues.displayBufferMode) {
+            updatedSettings.displayBufferMode = parseInt(formData.get("displayBufferMode"));
+        }
         if (formData.get("textColor") !== currentValues.textColor) {
             updatedSettings.textColor = formData.get("textColor");
         }
@@ -203,10 +224,14 @@ document.getElementById("settingsForm").addEventListener("submit", function(even
                 },
                 body: JSON.stringify(updatedSettings),
             })
-            .then(response => response.json())
-            .then(data => {
+            .then(response => response.json().then(data => ({ ok: response.ok, data })))
+            .then(({ ok, data }) => {
                 console.log(data);
                 console.log(updatedSettings);
+                if (!ok) {
+                    alert("Settings not saved: " + data.error);
+                    return;
+                }
                 alert("Settings saved successfully");
                 populateBoardInfo();
             })
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Convert an LVGL true-color image C file into a run-length encoded palette image.
+
+Reads the LV_COLOR_DEPTH == 32 section of an image exported by the LVGL image
+converter (B, G, R, A per pixel), builds a palette of at most 16 colors and writes
+a C file declaring an `rle_img_t` (see src/ui/rle_img.h).
+
+Runs are two bytes: (palette index << 4) | ((length - 1) >> 8), then (length - 1) & 0xFF,
+so a run covers up to 4096 pixels and may continue across rows.
+
+usage: img_rle_converter.py <input.c> <name> <output.c>
+"""
+import re
+import sys
+
+MAX_COLORS = 16
+MAX_RUN = 4096
+
+
+def read_argb32(path):
+    """Return (width, height, [argb, ...]) from an LVGL image C file."""
+    text = open(path).read()
+    width = int(re.search(r"\.header\.w\s*=\s*(\d+)", text).group(1))
+    height = int(re.search(r"\.header\.h\s*=\s*(\d+)", text).group(1))
+    cf = re.search(r"\.header\.cf\s*=\s*(\w+)", text).group(1)
+
+    data, inside = [], False
+    for line in text.split("\n"):
+        if line.startswith("#if LV_COLOR_DEPTH == 32"):
+            inside = True
+            continue
+        if inside and line.startswith("#endif"):
+            break
+        if inside:
+            line = re.sub(r"/\*.*?\*/", "", line)
+            data += [int(x, 16) for x in re.findall(r"0x[0-9a-fA-F]+", line)]
+
+    if len(data) != width * height * 4:
+        sys.exit(f"{path}: expected {width * height * 4} bytes, found {len(data)}")
+
+    pixels = []
+    for i in range(0, len(data), 4):
+        b, g, r, a = data[i:i + 4]
+        if cf == "LV_IMG_CF_TRUE_COLOR":
+            a = 0xFF
+        pixels.append((a << 24) | (r << 16) | (g << 8) | b)
+    return width, height, pixels
+
+
+def encode(pixels):
+    palette = []
+    for p in pixels:
+        if p not in palette:
+            palette.append(p)
+    if len(palette) > MAX_COLORS:
+        sys.exit(f"image has {len(palette)} colors, at most {MAX_COLORS} supported")
+
+    runs = []
+    i = 0
+    while i < len(pixels):
+        j = i
+        while j < len(pixels) and pixels[j] == pixels[i] and j - i < MAX_RUN:
+            j += 1
+        idx, length = palette.index(pixels[i]), j - i
+        runs += [(idx << 4) | ((length - 1) >> 8), (length - 1) & 0xFF]
+        i = j
+    return palette, runs
+
+
+def write_c(path, name, width, height, palette, runs):
+    with open(path, "w") as f:
+        f.write(f"// Generated by img_rle_converter.py - {width}x{height}, "
+                f"{len(palette)} colors, {len(runs)} bytes RLE ({width * height * 2} bytes raw RGB565)\n")
+        f.write('#include "rle_img.h"\n\n')
+        f.write(f"static const uint32_t {name}_palette[] = {{\n    ")
+        f.write(", ".join(f"0x{c:08x}" for c in palette))
+        f.write("\n};\n\n")
+        f.write(f"static const uint8_t {name}_runs[] = {{\n")
+        for i in range(0, len(runs), 16):
+            f.write("    " + ", ".join(f"0x{b:02x}" for b in runs[i:i + 16]) + ",\n")
+        f.write("};\n\n")
+        f.write(f"const rle_img_t {name} = {{\n")
+        f.write(f"    .w = {width},\n")
+        f.write(f"    .h = {height},\n")
+        f.write(f"    .palette_size = {len(palette)},\n")
+        f.write(f"    .palette = {name}_palette,\n")
+        f.write(f"    .runs_size = sizeof({name}_runs),\n")
+        f.write(f"    .runs = {name}_runs,\n")
+        f.write("};\n")
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit(__doc__)
+    src, name, dst = sys.argv[1:]
+    width, height, pixels = read_argb32(src)
+    palette, runs = encode(pixels)
+    write_c(dst, name, width, height, palette, runs)
+    print(f"{name}: {width}x{height}, {len(palette)} colors, {len(runs)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -35,6 +35,11 @@
 volatile bool touchInterrupt = false;
 
 #if defined(ARDUINO)
+#include "esp_timer.h"
+
+volatile int64_t touchInterruptUs = 0;
+TaskHandle_t touchNotifyTask = NULL;
+
 TouchClassCST226::TouchClassCST226()
 {
 
@@ -42,6 +47,12 @@ TouchClassCST226::TouchClassCST226()
 
 void IRAM_ATTR touchISR() {
     touchInterrupt = true;
+    touchInterruptUs = esp_timer_get_time();
+    if (touchNotifyTask) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(touchNotifyTask, &woken);
+        if (woken) portYIELD_FROM_ISR();
+    }
     //Serial.println("Touch detected!");
 }
 
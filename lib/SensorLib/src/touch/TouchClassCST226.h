@@ -32,6 +32,13 @@
 #include "../SensorCommon.tpp"
 
 extern volatile bool touchInterrupt;
+#if defined(ARDUINO)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+// time of the last INT edge, and the task woken by it (NULL = flag only)
+extern volatile int64_t touchInterruptUs;
+extern TaskHandle_t touchNotifyTask;
+#endif
 
 class TouchClassCST226 : public TouchDrvInterface,
     public SensorCommon<TouchClassCST226>
@@ -9,6 +9,7 @@
 #include <Arduino.h>
 #include "LV_Helper.h"
 #include "TouchDrvCSTXXX.hpp"
+#include "touch.h"
 
 
 #if LV_VERSION_CHECK(9,0,0)
@@ -22,6 +23,10 @@ static lv_indev_t  *mouse_indev = NULL;
 static lv_indev_t  *kb_indev = NULL;
 static lv_indev_drv_t indev_mouse;
 static lv_indev_drv_t indev_keypad;
+static bool te_sync = false;
+static uint8_t buffer_mode = LVGL_BUFFER_SLICE;
+
+static const char *buffer_mode_names[] = { "auto", "slice", "large", "psram" };
 //static struct InputParams params_copy;
 
 
@@ -34,36 +39,74 @@ static void disp_flush( lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color
     lv_disp_flush_ready( disp_drv );
 }
 
+// Time the flush callbacks spent blocked on the TE edge since the last take; flushes
+// run inside lv_task_handler on the UI task, which is also the only reader
+static uint32_t te_wait_us = 0;
+
+uint32_t takeLvglTeWaitUs()
+{
+    uint32_t us = te_wait_us;
+    te_wait_us = 0;
+    return us;
+}
+
+static void wait_for_te(lv_disp_drv_t *disp_drv)
+{
+    uint32_t start = micros();
+    static_cast<LilyGo_Display *>(disp_drv->user_data)->waitForTE(LVGL_TE_TIMEOUT_MS);
+    te_wait_us += micros() - start;
+}
+
 /* DMA display flush */
+static void IRAM_ATTR disp_flush_ready_isr(void *arg)
+{
+    lv_disp_flush_ready((lv_disp_drv_t *)arg);
+}
+
 static void disp_flush_v2(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p) {
+    static bool frame_start = true;
     uint32_t w = (area->x2 - area->x1 + 1);
     uint32_t h = (area->y2 - area->y1 + 1);
+
+    // start each refresh on the vsync edge so the scan-out never overtakes the write
+    if (frame_start && te_sync) {
+        wait_for_te(disp_drv);
+    }
+    frame_start = lv_disp_flush_is_last(disp_drv);
     
+    // setAddrWindow waits for the previous flush to leave the bus before sending CASET/RASET
     static_cast<LilyGo_Display *>(disp_drv->user_data)->setAddrWindow(area->x1, area->y1, area->x2, area->y2);
 
+    // returns once queued; lv_disp_flush_ready comes from the SPI post callback so
+    // LVGL can render into the other buffer while this one streams out
     static_cast<LilyGo_Display *>(disp_drv->user_data)->pushColorsDMA_v2((uint16_t *)color_p, w * h);
     //Serial.printf("Buffer address: %p (aligned: %s)\n", color_p, ((uintptr_t)color_p % 4 == 0) ? "YES" : "NO");
+}
 
-    lv_disp_flush_ready(disp_drv);
+/* PSRAM framebuffer flush, streamed through internal bounce buffers */
+static void disp_flush_bounce(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p) {
+    static bool frame_start = true;
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+
+    if (frame_start && te_sync) {
+        wait_for_te(disp_drv);
+    }
+    frame_start = lv_disp_flush_is_last(disp_drv);
+
+    static_cast<LilyGo_Display *>(disp_drv->user_data)->setAddrWindow(area->x1, area->y1, area->x2, area->y2);
+    static_cast<LilyGo_Display *>(disp_drv->user_data)->pushColorsBounce((uint16_t *)color_p, w * h);
 }
 
-/*Read the touchpad*/
+/*Read the touchpad: the last point from the touch reader task, no I2C here*/
 static void touchpad_read( lv_indev_drv_t *indev_driver, lv_indev_data_t *data )
 {
-    static int16_t x, y;
-    
-    if (touchInterrupt) {
-        touchInterrupt = false;
+    int16_t x, y;
 
-        uint8_t touched = static_cast<LilyGo_Display *>(indev_driver->user_data)->getPoint(&x, &y, 1);
-        if ( touched ) {
-            data->point.x = x;
-            data->point.y = y;
-            data->state = LV_INDEV_STATE_PR;
-            //return;
-        } else {
-            data->state = LV_INDEV_STATE_REL;
-        }
+    if (getTouchPoint(x, y)) {
+        data->point.x = x;
+        data->point.y = y;
+        data->state = LV_INDEV_STATE_PR;
     } else {
         data->state = LV_INDEV_STATE_REL;
     }
@@ -181,7 +224,29 @@ void beginLvglHelper(LilyGo_Display &board, bool debug) {
     lv_group_set_default(lv_group_create());
 }
 
-void beginLvglHelperDMA(LilyGo_Display &board, bool debug) {
+// Pick the draw buffer layout from what is left of internal DMA RAM after WiFi/BLE
+// are up. Larger slices mean fewer flushes per full-screen change.
+static uint8_t select_buffer_mode(uint8_t requested, size_t slice_bytes, size_t large_bytes)
+{
+    size_t free_dma = heap_caps_get_free_size(MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    size_t largest_dma = heap_caps_get_largest_free_block(MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    Serial.printf("LVGL: free DMA heap %u, largest block %u\n", free_dma, largest_dma);
+
+    if (requested > LVGL_BUFFER_PSRAM_FULL) {
+        Serial.printf("LVGL: unknown buffer mode %u, using auto\n", requested);
+    } else if (requested != LVGL_BUFFER_AUTO) {
+        return requested;
+    }
+    if (free_dma >= 2 * large_bytes + LVGL_DMA_HEAP_RESERVE && largest_dma >= large_bytes) {
+        return LVGL_BUFFER_LARGE;
+    }
+    if (free_dma >= 2 * slice_bytes + LVGL_DMA_HEAP_RESERVE && largest_dma >= slice_bytes) {
+        return LVGL_BUFFER_SLICE;
+    }
+    return LVGL_BUFFER_PSRAM_FULL;
+}
+
+void beginLvglHelperDMA(LilyGo_Display &board, bool debug, uint8_t mode) {
 
     lv_init();
 
@@ -191,31 +256,53 @@ void beginLvglHelperDMA(LilyGo_Display &board, bool debug) {
         }
     #endif
 
-    /*
-    size_t lv_buffer_size = (board.width() * board.height() / 2) * sizeof(lv_color_t);
-    lv_color_t *buf1 = (lv_color_t *)ps_malloc(lv_buffer_size);
-    lv_color_t *buf2 = (lv_color_t *)ps_malloc(lv_buffer_size);
-    */
-    size_t lv_buffer_size = (board.width() * board.height() / 10) * sizeof(lv_color_t);  // Reduce buffer size to fit DMA
-
-    lv_color_t *buf1 = (lv_color_t *)heap_caps_malloc(lv_buffer_size, MALLOC_CAP_DMA);
-    lv_color_t *buf2 = (lv_color_t *)heap_caps_malloc(lv_buffer_size, MALLOC_CAP_DMA);
-    //lv_color_t *buf1 = (lv_color_t *)heap_caps_malloc(lv_buffer_size, MALLOC_CAP_DMA | MALLOC_CAP_SPIRAM);
-    // lv_color_t *buf2 = (lv_color_t *)heap_caps_malloc(lv_buffer_size, MALLOC_CAP_DMA | MALLOC_CAP_SPIRAM);
-
-    assert(buf1 && buf2);
-
-    if (!esp_ptr_dma_capable(buf1) || !esp_ptr_dma_capable(buf2)) {
-        Serial.println("ERROR: Buffers are NOT DMA-capable!");
+    uint32_t screen_px = board.width() * board.height();
+    uint32_t slice_px = screen_px / 10;
+    uint32_t large_px = screen_px / 4;
+
+    buffer_mode = select_buffer_mode(mode, slice_px * sizeof(lv_color_t), large_px * sizeof(lv_color_t));
+
+    lv_color_t *buf1 = NULL;
+    lv_color_t *buf2 = NULL;
+    uint32_t buf_px = 0;
+
+    if (buffer_mode == LVGL_BUFFER_LARGE) {
+        buf_px = large_px;
+        buf1 = (lv_color_t *)heap_caps_malloc(buf_px * sizeof(lv_color_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        buf2 = (lv_color_t *)heap_caps_malloc(buf_px * sizeof(lv_color_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        if (!buf1 || !buf2) {
+            Serial.println("LVGL: large buffers failed, falling back to slices");
+            free(buf1);
+            free(buf2);
+            buf1 = buf2 = NULL;
+            buffer_mode = LVGL_BUFFER_SLICE;
+        }
+    }
+    if (buffer_mode == LVGL_BUFFER_SLICE) {
+        buf_px = slice_px;
+        buf1 = (lv_color_t *)heap_caps_malloc(buf_px * sizeof(lv_color_t), MALLOC_CAP_DMA);
+        buf2 = (lv_color_t *)heap_caps_malloc(buf_px * sizeof(lv_color_t), MALLOC_CAP_DMA);
+        assert(buf1 && buf2);
+
+        if (!esp_ptr_dma_capable(buf1) || !esp_ptr_dma_capable(buf2)) {
+            Serial.println("ERROR: Buffers are NOT DMA-capable!");
+        }
+    }
+    if (buffer_mode == LVGL_BUFFER_PSRAM_FULL) {
+        // one full frame; LVGL still renders only the dirty areas into it
+        buf_px = screen_px;
+        buf1 = (lv_color_t *)heap_caps_aligned_alloc(16, buf_px * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+        assert(buf1);
     }
 
-    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, board.width() * board.height() / 10);
+    Serial.printf("LVGL: %s draw buffers, %u px each\n", buffer_mode_names[buffer_mode], buf_px);
+    lv_disp_draw_buf_init(&draw_buf, buf1, buf2, buf_px);
 
     /*Initialize the display*/
     lv_disp_drv_init( &disp_drv );
     disp_drv.hor_res = board.width();
     disp_drv.ver_res = board.height();
-    disp_drv.flush_cb = disp_flush_v2;
+    disp_drv.flush_cb = (buffer_mode == LVGL_BUFFER_PSRAM_FULL) ? disp_flush_bounce : disp_flush_v2;
     disp_drv.draw_buf = &draw_buf;
     bool full_refresh = board.needFullRefresh();
     disp_drv.full_refresh = full_refresh;
@@ -224,6 +311,8 @@ void beginLvglHelperDMA(LilyGo_Display &board, bool debug) {
         disp_drv.rounder_cb = lv_rounder_cb;
     }
     lv_disp_drv_register( &disp_drv );
+    board.setFlushReadyCallback(disp_flush_ready_isr, &disp_drv);
+    te_sync = board.enableTE();
 
     if (board.hasTouch()) {
         lv_indev_drv_init( &indev_drv );
@@ -237,6 +326,58 @@ void beginLvglHelperDMA(LilyGo_Display &board, bool debug) {
     lv_group_set_default(lv_group_create());
 }
 
+// Drop to a couple of frames per second when nothing is changing and go back to
+// full rate (with an immediate refresh) as soon as an alert, blink or animation starts.
+void updateLvglRefreshRate(bool active)
+{
+    static bool was_active = true;
+    if (active == was_active) return;
+    was_active = active;
+
+    lv_timer_t *refr_timer = _lv_disp_get_refr_timer(NULL);
+    if (!refr_timer) return;
+
+    lv_timer_set_period(refr_timer, active ? LVGL_ACTIVE_REFR_PERIOD : LVGL_IDLE_REFR_PERIOD);
+    if (active) {
+        lv_timer_ready(refr_timer);
+    }
+}
+
+uint8_t getLvglBufferMode()
+{
+    return buffer_mode;
+}
+
+const char *getLvglBufferModeName()
+{
+    return buffer_mode_names[buffer_mode];
+}
+
+// Forces full-screen redraws of the active screen and returns frames per second.
+// TE sync is suspended so the number reflects render + transfer cost only.
+float runLvglBenchmark(uint16_t frames)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    if (!disp || !frames) return 0;
+
+    LilyGo_Display *board = static_cast<LilyGo_Display *>(disp->driver->user_data);
+    bool te = te_sync;
+    te_sync = false;
+
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < frames; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(disp);
+    }
+    board->waitDMADone();
+    uint32_t elapsed = micros() - start;
+
+    te_sync = te;
+    float fps = frames * 1000000.0f / elapsed;
+    Serial.printf("LVGL benchmark: %u full redraws in %u us, %.1f fps (%s)\n", frames, elapsed, fps, getLvglBufferModeName());
+    return fps;
+}
+
 /*
 void beginLvglInputDevice(struct InputParams prams)
 {
@@ -12,9 +12,31 @@
 #include "LilyGo_Display.h"
 //#include "InputParams.h"
 
+// Refresh period while something on screen is changing vs. a static display
+#define LVGL_ACTIVE_REFR_PERIOD LV_DISP_DEF_REFR_PERIOD
+#define LVGL_IDLE_REFR_PERIOD   500
+// Longest a flush will wait for the panel's TE edge (one frame at ~60 Hz plus slack)
+#define LVGL_TE_TIMEOUT_MS      20
+
 
 void beginLvglHelper(LilyGo_Display &board, bool debug = false);
-void beginLvglHelperDMA(LilyGo_Display &board, bool debug = false);
+enum LvglBufferMode : uint8_t {
+    LVGL_BUFFER_AUTO = 0,       // chosen at boot from free internal DMA heap
+    LVGL_BUFFER_SLICE,          // 2 x 1/10 screen in internal DMA RAM
+    LVGL_BUFFER_LARGE,          // 2 x 1/4 screen in internal DMA RAM
+    LVGL_BUFFER_PSRAM_FULL,     // full frame in PSRAM, sent through internal bounce buffers
+};
+
+// internal DMA heap left untouched for WiFi/BLE when picking a buffer mode
+#define LVGL_DMA_HEAP_RESERVE   (64 * 1024)
+#define LVGL_BENCHMARK_FRAMES   30
+
+void beginLvglHelperDMA(LilyGo_Display &board, bool debug = false, uint8_t mode = LVGL_BUFFER_AUTO);
+void updateLvglRefreshRate(bool active);
+uint8_t getLvglBufferMode();
+const char *getLvglBufferModeName();
+float runLvglBenchmark(uint16_t frames);
+uint32_t takeLvglTeWaitUs();    // TE wait inside flushes since the last call, UI task only
 //void beginLvglInputDevice(struct InputParams prams);
 
 
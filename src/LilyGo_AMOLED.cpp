@@ -9,6 +9,7 @@
 
 #include "LilyGo_AMOLED.h"
 #include <driver/gpio.h>
+#include <hal/gpio_ll.h>
 #include <vector>
 
 #if ESP_ARDUINO_VERSION < ESP_ARDUINO_VERSION_VAL(3,0,0)
@@ -41,14 +42,47 @@
 #endif
 
 #define SEND_BUF_SIZE           (16384)
+#define BOUNCE_BUF_SIZE         (8192)
 #define TFT_SPI_MODE            SPI_MODE0
 #define DEFAULT_SPI_HANDLER    (SPI3_HOST)
 
+// marks the final chunk of an async flush; its post_cb releases CS and signals LVGL
+#define DMA_LAST_CHUNK          ((void *)1)
+
+static void (*flushReadyCb)(void *) = NULL;
+static void *flushReadyArg = NULL;
+static int dmaCsPin = -1;
+
+// runs in the SPI ISR, so everything it touches must be in IRAM
+static void IRAM_ATTR dma_post_cb(spi_transaction_t *t)
+{
+    if (t->user == DMA_LAST_CHUNK) {
+        gpio_ll_set_level(&GPIO, (gpio_num_t)dmaCsPin, 1);
+        if (flushReadyCb) {
+            flushReadyCb(flushReadyArg);
+        }
+    }
+}
+
+static SemaphoreHandle_t teSemaphore = NULL;
+
+static void IRAM_ATTR te_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(teSemaphore, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
 LilyGo_AMOLED::LilyGo_AMOLED() : boards(NULL), _hasRTC(false), _disableTouch(false)
 {
     spiDev = NULL;
     pBuffer = NULL;
     spi = NULL;
+    dmaHead = 0;
+    dmaInFlight = 0;
+    bounceBuf[0] = bounceBuf[1] = NULL;
     _brightness = AMOLED_DEFAULT_BRIGHTNESS;
     // Prevent previously set hold
     switch (esp_sleep_get_wakeup_cause()) {
@@ -429,8 +463,10 @@ bool LilyGo_AMOLED::initBUS(DriverBusType type)
             .spics_io_num = -1,
             .flags = SPI_DEVICE_HALFDUPLEX,
             //.flags = SPI_TRANS_MODE_QIO,
-            .queue_size = 17,
+            .queue_size = DMA_TRANS_POOL + 1,
+            .post_cb = dma_post_cb,
         };
+        dmaCsPin = boards->display.cs;
         esp_err_t ret = spi_bus_initialize(DEFAULT_SPI_HANDLER, &buscfg, SPI_DMA_CH_AUTO);
         if (ret != ESP_OK) {
             log_e("spi_bus_initialize fail!");
@@ -751,7 +787,8 @@ void LilyGo_AMOLED::writeCommand(uint32_t cmd, uint8_t *pdat, uint32_t length)
         return;
     }
 
-    // QSPI
+    // QSPI - polling transactions may not overlap queued ones
+    waitDMADone();
     setCS();
     spi_transaction_t t;
     memset(&t, 0, sizeof(t));
@@ -873,16 +910,108 @@ void LilyGo_AMOLED::setAddrWindow(uint16_t xs, uint16_t ys, uint16_t xe, uint16_
 }
 
 bool LilyGo_AMOLED::checkDisplayReady() {
-    int tePin = 18;
-    pinMode(tePin, INPUT);
+    if (!boards || boards->display.te < 0) return true;
+    pinMode(boards->display.te, INPUT);
     
-    return digitalRead(tePin) == HIGH;
+    return digitalRead(boards->display.te) == HIGH;
+}
+
+// The init sequence already turns the panel's tearing-effect output on (0x35),
+// so this only hooks its rising edge (start of vertical blanking).
+bool LilyGo_AMOLED::enableTE()
+{
+    if (!boards || boards->display.te < 0) return false;
+    if (teSemaphore) return true;
+
+    teSemaphore = xSemaphoreCreateBinary();
+    if (!teSemaphore) return false;
+
+    pinMode(boards->display.te, INPUT);
+    attachInterruptArg(boards->display.te, te_isr, NULL, RISING);
+    log_i("TE sync enabled on GPIO %d", boards->display.te);
+    return true;
 }
 
+// Blocks until the next vsync edge; a stale edge from an earlier frame is discarded
+bool LilyGo_AMOLED::waitForTE(uint32_t timeout_ms)
+{
+    if (!teSemaphore) return false;
+    xSemaphoreTake(teSemaphore, 0);
+    return xSemaphoreTake(teSemaphore, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+void LilyGo_AMOLED::setFlushReadyCallback(void (*cb)(void *), void *arg)
+{
+    flushReadyCb = cb;
+    flushReadyArg = arg;
+}
+
+// Collect every finished transaction so the pool slots and the bus are free again
+void LilyGo_AMOLED::waitDMADone()
+{
+    while (dmaInFlight) {
+        spi_transaction_t *trans_result;
+        if (spi_device_get_trans_result(spi, &trans_result, portMAX_DELAY) != ESP_OK) {
+            log_e("DMA SPI transfer failed!");
+            dmaInFlight = 0;
+            break;
+        }
+        dmaInFlight--;
+    }
+}
+
+// Queue one chunk of a RAMWR stream from the transaction ring. Only the first chunk
+// carries the QIO write command; the last one is tagged for the post callback.
+bool LilyGo_AMOLED::queueDMAChunk(uint16_t *data, size_t pixels, bool first, bool last)
+{
+    if (dmaInFlight == DMA_TRANS_POOL) {
+        spi_transaction_t *trans_result;
+        spi_device_get_trans_result(spi, &trans_result, portMAX_DELAY);
+        dmaInFlight--;
+    }
+
+    spi_transaction_ext_t &t = dmaTrans[dmaHead];
+    dmaHead = (dmaHead + 1) % DMA_TRANS_POOL;
+    memset(&t, 0, sizeof(t));
+
+    // Setup the first transaction differently
+    if (first) {
+        t.base.flags = SPI_TRANS_MODE_QIO;
+        t.base.cmd = 0x32;  // Modify as necessary
+        t.base.addr = 0x002C00;  // Modify as necessary
+    } else {
+        t.base.flags = SPI_TRANS_MODE_QIO | SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY;
+        t.command_bits = 0;
+        t.address_bits = 0;
+        t.dummy_bits = 0;
+    }
+
+    t.base.tx_buffer = data;
+    t.base.length = pixels * 16;  // Multiply by 16 for bit-length
+    t.base.user = last ? DMA_LAST_CHUNK : NULL;
+
+    esp_err_t ret = spi_device_queue_trans(spi, &t.base, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        Serial.printf("DMA transfer failed: %d\n", ret);
+        waitDMADone();
+        clrCS();
+        if (flushReadyCb) flushReadyCb(flushReadyArg);
+        return false;
+    }
+    dmaInFlight++;
+    return true;
+}
+
+// Queues the whole region and returns immediately. CS is released and the
+// flush-ready callback fired from post_cb once the last chunk is on the wire.
 void LilyGo_AMOLED::pushColorsDMA_v2(uint16_t *data, uint32_t len) {
-    if (!spi) return;
+    if (!spi || !len) {
+        if (flushReadyCb) flushReadyCb(flushReadyArg);
+        return;
+    }
 
     bool first_send = true;
+    waitDMADone();
     setCS();  // Set chip select
 
     while (len > 0) {
@@ -890,46 +1019,57 @@ void LilyGo_AMOLED::pushColorsDMA_v2(uint16_t *data, uint32_t len) {
         if (chunk_size > SEND_BUF_SIZE) {
             chunk_size = SEND_BUF_SIZE;
         }
+        len -= chunk_size;
+        if (!queueDMAChunk(data, chunk_size, first_send, len == 0)) return;
+        first_send = false;
+        data += chunk_size;
+    }
+}
 
-        spi_transaction_ext_t t = {0};
-        memset(&t, 0, sizeof(t));
+// Same stream for a source the DMA cannot read (PSRAM framebuffer): each chunk is
+// copied into one of two internal bounce buffers while the other one is on the wire.
+void LilyGo_AMOLED::pushColorsBounce(uint16_t *data, uint32_t len) {
+    if (!spi || !len) {
+        if (flushReadyCb) flushReadyCb(flushReadyArg);
+        return;
+    }
 
-        // Setup the first transaction differently
-        if (first_send) {
-            t.base.flags = SPI_TRANS_MODE_QIO;
-            t.base.cmd = 0x32;  // Modify as necessary
-            t.base.addr = 0x002C00;  // Modify as necessary
-            first_send = 0;
-        } else {
-            t.base.flags = SPI_TRANS_MODE_QIO | SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY;
-            t.command_bits = 0;
-            t.address_bits = 0;
-            t.dummy_bits = 0;
+    if (!bounceBuf[0]) {
+        for (int i = 0; i < 2; i++) {
+            bounceBuf[i] = (uint16_t *)heap_caps_malloc(BOUNCE_BUF_SIZE * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
         }
+        if (!bounceBuf[0] || !bounceBuf[1]) {
+            log_e("bounce buffer allocation failed!");
+            if (flushReadyCb) flushReadyCb(flushReadyArg);
+            return;
+        }
+    }
 
-        t.base.tx_buffer = data;
-        t.base.length = chunk_size * 16;  // Multiply by 16 for bit-length
-
-        //bool is_dma = esp_ptr_dma_capable(data);
-        //Serial.printf("Transferring buffer at %p (DMA: %s)\n", data, is_dma ? "YES" : "NO");
+    bool first_send = true;
+    uint8_t next = 0;
+    waitDMADone();
+    setCS();
 
-        esp_err_t ret = spi_device_queue_trans(spi, &t.base, portMAX_DELAY);
-        if (ret != ESP_OK) {
-            Serial.printf("DMA transfer failed: %d\n", ret);
+    while (len > 0) {
+        size_t chunk_size = len;
+        if (chunk_size > BOUNCE_BUF_SIZE) {
+            chunk_size = BOUNCE_BUF_SIZE;
         }
 
-        spi_transaction_t *trans_result;
-        ret = spi_device_get_trans_result(spi, &trans_result, portMAX_DELAY);
-        if (ret != ESP_OK) {
-            log_e("DMA SPI transfer failed!");
+        // results come back in order, so reclaiming the oldest frees this buffer
+        if (dmaInFlight >= 2) {
+            spi_transaction_t *trans_result;
+            spi_device_get_trans_result(spi, &trans_result, portMAX_DELAY);
+            dmaInFlight--;
         }
 
-        // Move data pointer and decrease length
-        data += chunk_size;
+        memcpy(bounceBuf[next], data, chunk_size * sizeof(uint16_t));
         len -= chunk_size;
+        if (!queueDMAChunk(bounceBuf[next], chunk_size, first_send, len == 0)) return;
+        first_send = false;
+        data += chunk_size;
+        next ^= 1;
     }
-
-    clrCS();  // Clear chip select
 }
 
 
@@ -950,6 +1090,7 @@ void LilyGo_AMOLED::pushColors(uint16_t *data, uint32_t len)
     uint16_t *p = data;
     assert(p);
     assert(spi);
+    waitDMADone();
     setCS();
     do {
         size_t chunk_size = len;
@@ -978,6 +1119,43 @@ void LilyGo_AMOLED::pushColors(uint16_t *data, uint32_t len)
     clrCS();
 }
 
+// Rotate a width x hight RGB565 region 90 degrees clockwise into dst (hight x width):
+// dst[j * hight + i] = src[width * (hight - 1 - i) + j]
+// Works on 16x16 tiles so both the source rows and destination rows of a tile stay
+// in cache, and moves 2x2 pixel blocks with 32-bit loads/stores when the rounder has
+// made both sides even.
+#define ROTATE_TILE 16
+
+static void rotate90(const uint16_t *src, uint16_t *dst, uint16_t width, uint16_t hight)
+{
+    if ((width | hight) & 1) {
+        uint32_t cum = 0;
+        for (uint16_t j = 0; j < width; j++) {
+            for (uint16_t i = 0; i < hight; i++) {
+                dst[cum++] = src[width * (hight - i - 1) + j];
+            }
+        }
+        return;
+    }
+
+    for (uint16_t tj = 0; tj < width; tj += ROTATE_TILE) {
+        uint16_t je = min<uint16_t>(tj + ROTATE_TILE, width);
+        for (uint16_t ti = 0; ti < hight; ti += ROTATE_TILE) {
+            uint16_t ie = min<uint16_t>(ti + ROTATE_TILE, hight);
+            for (uint16_t i = ti; i < ie; i += 2) {
+                const uint32_t *rowA = (const uint32_t *)(src + width * (hight - 1 - i));
+                const uint32_t *rowB = (const uint32_t *)(src + width * (hight - 2 - i));
+                for (uint16_t j = tj; j < je; j += 2) {
+                    uint32_t a = rowA[j >> 1];   // src(h-1-i, j), src(h-1-i, j+1)
+                    uint32_t b = rowB[j >> 1];   // src(h-2-i, j), src(h-2-i, j+1)
+                    *(uint32_t *)(dst + j * hight + i) = (a & 0xFFFF) | (b << 16);
+                    *(uint32_t *)(dst + (j + 1) * hight + i) = (a >> 16) | (b & 0xFFFF0000);
+                }
+            }
+        }
+    }
+}
+
 void LilyGo_AMOLED::pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t hight, uint16_t *data)
 {
     // make sure to change this back to remove the !
@@ -987,14 +1165,7 @@ void LilyGo_AMOLED::pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t
         uint16_t _y = x;
         uint16_t _h = width;
         uint16_t _w = hight;
-        uint16_t *p = data;
-        uint32_t cum = 0;
-        for (uint16_t j = 0; j < width; j++) {
-            for (uint16_t i = 0; i < hight; i++) {
-                pBuffer[cum] = ((uint16_t)p[width * (hight - i - 1) + j]);
-                cum++;
-            }
-        }
+        rotate90(data, pBuffer, width, hight);
         setAddrWindow(_x, _y, _x + _w - 1, _y + _h - 1);
         pushColors(pBuffer, width * hight);
     } else {
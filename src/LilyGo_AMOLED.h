@@ -294,9 +294,14 @@ class LilyGo_AMOLED:
 public:
     // KG
     void pushColorsDMA_v2(uint16_t *data, uint32_t len);
+    void pushColorsBounce(uint16_t *data, uint32_t len);
+    void setFlushReadyCallback(void (*cb)(void *), void *arg);
+    void waitDMADone();
     void setAddrWindow_v2(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye);
     void writeCommand_v2(uint32_t cmd, uint8_t *pdat, uint32_t length);
     bool checkDisplayReady();
+    bool enableTE();
+    bool waitForTE(uint32_t timeout_ms);
     // LILYGO_AMOLED_241 USE SY6970
     PowersSY6970 SY;
     // LILYGO_AMOLED_191_SPI USE BQ25896
@@ -414,6 +419,14 @@ private:
     void writeCommand(uint32_t cmd, uint8_t *pdat, uint32_t length);
     uint16_t *pBuffer;
     spi_device_handle_t spi;
+
+    // async flush: ring of transactions owned by the SPI driver until reclaimed
+    static constexpr uint8_t DMA_TRANS_POOL = 16;
+    spi_transaction_ext_t dmaTrans[DMA_TRANS_POOL];
+    uint8_t dmaHead;
+    uint8_t dmaInFlight;
+    uint16_t *bounceBuf[2];
+    bool queueDMAChunk(uint16_t *data, size_t pixels, bool first, bool last);
     uint8_t _brightness;
     const BoardsConfigure_t *boards;
     bool _touchOnline;
@@ -29,6 +29,11 @@ public:
 
     //KG
     virtual void pushColorsDMA_v2(uint16_t *data, uint32_t len) = 0;
+    virtual void pushColorsBounce(uint16_t *data, uint32_t len) = 0;
+    virtual void setFlushReadyCallback(void (*cb)(void *), void *arg) = 0;
+    virtual void waitDMADone() = 0;
+    virtual bool enableTE() = 0;
+    virtual bool waitForTE(uint32_t timeout_ms) = 0;
     virtual void setAddrWindow_v2(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye) = 0;
 
     virtual uint8_t getPoint(int16_t *x, int16_t *y, uint8_t get_point ) = 0;
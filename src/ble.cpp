@@ -3,6 +3,16 @@
 #include "v1_config.h"
 #include "utils.h"
 #include "ui/blinking.h"
+#include "proxy.h"
+#include "v1_cmd.h"
+#include "v1_handshake.h"
+#include "v1_link.h"
+
+#if defined(CONFIG_NIMBLE_CPP_IDF)
+#include "host/ble_hs.h"
+#else
+#include "nimble/nimble/host/include/host/ble_hs.h"
+#endif
 
 bool serialReceived = false;
 bool versionReceived = false;
@@ -15,14 +25,8 @@ bool allSweepDefinitionsReceived = false;
 std::vector<uint8_t> latestRawData;
 std::vector<uint8_t> previousRawData;
 
-SemaphoreHandle_t bleMutex;
-SemaphoreHandle_t bleNotifyMutex;
-
-static constexpr uint32_t scanTimeMs = 5 * 1000;
-
 bool bleInit = true;
 bool newDataAvailable = false;
-static bool notifySubscribed = false;
 bool needsMode = true;
 
 NimBLERemoteService* dataRemoteService = nullptr;
@@ -95,111 +99,109 @@ class ClientCallbacks : public NimBLEClientCallbacks {
     Serial.printf("BLE Connected to: %s on core %d\n", pClient->getPeerAddress().toString().c_str(), xPortGetCoreID());
     bt_connected = true;
     bleInit = true;
-    bleNotifyMutex = xSemaphoreCreateMutex();
+    handshakeConnected();
+    v1LinkConnected(pClient->getPeerAddress());
+    ble_gap_set_data_len(pClient->getConnHandle(), BLE_DLE_TX_OCTETS, BLE_DLE_TX_TIME);
   }
 
   void onDisconnect(NimBLEClient* pClient, int reason) override {
-    Serial.printf("%s Disconnected, reason = %d - Restarting scan in 2s\n", 
+    Serial.printf("%s Disconnected, reason = %d - reconnecting\n", 
                   pClient->getPeerAddress().toString().c_str(), reason);
 
     bt_connected = false;
+    v1CmdFlush();
     if (settings.proxyBLE) {
       NimBLEDevice::stopAdvertising();
     }
-
-    xTaskCreate([](void*){
-      vTaskDelay(pdMS_TO_TICKS(2000));
-      NimBLEDevice::getScan()->start(scanTimeMs);
-      vTaskDelete(NULL);
-    }, "BLEScanRestart", 2048, NULL, 1, NULL);
+    v1LinkDisconnected();
   }
 
   void onConnectFail(NimBLEClient* pClient, int reason) override {
     Serial.printf("%s Connect failed, reason = %d\n", 
       pClient->getPeerAddress().toString().c_str(), reason);
+    v1LinkConnectFailed();
   }
 } clientCallbacks;
+
+// First three characters of the advertised name, read from the raw payload so the
+// scan callback doesn't build a std::string per advertisement
+static bool advNamePrefix(const NimBLEAdvertisedDevice* advertisedDevice, char prefix[3]) {
+  const std::vector<uint8_t>& payload = advertisedDevice->getPayload();
+  size_t i = 0;
+  while (i + 1 < payload.size()) {
+    uint8_t len = payload[i];
+    if (len == 0 || i + 1 + len > payload.size()) break;
+    uint8_t type = payload[i + 1];
+    if ((type == BLE_HS_ADV_TYPE_COMP_NAME || type == BLE_HS_ADV_TYPE_INCOMP_NAME) && len > 3) {
+      memcpy(prefix, &payload[i + 2], 3);
+      return true;
+    }
+    i += len + 1;
+  }
+  return false;
+}
+
+bool connectV1(const NimBLEAddress& address, bool async) {
+  pClient = NimBLEDevice::getClientByPeerAddress(address);
+  if (!pClient) {
+    pClient = NimBLEDevice::createClient(address);
+    if (!pClient) {
+      Serial.printf("Failed to create client\n");
+      return false;
+    }
+  }
+  pClient->setClientCallbacks(&clientCallbacks, false);
+  pClient->setConnectTimeout(V1_CONNECT_TIMEOUT_MS);
+
+  if (!pClient->connect(true, async, true)) {
+    Serial.println("Failed to connect, deleting client...");
+    NimBLEDevice::deleteClient(pClient);
+    pClient = nullptr;
+    return false;
+  }
+  return true;
+}
   
 class ScanCallbacks : public NimBLEScanCallbacks {
   void onResult(const NimBLEAdvertisedDevice* advertisedDevice) override {
+    if (bt_connected || !advertisedDevice->isAdvertisingService(bmeServiceUUID)) return;
+
+    // a passive scan may not carry the name (it can sit in the scan response); then
+    // the configured V1 type decides
+    char prefix[3];
+    bool le = settings.useV1LE;
+    if (advNamePrefix(advertisedDevice, prefix)) {
+      if (memcmp(prefix, "V1C", 3) == 0) le = true;
+      else if (memcmp(prefix, "V1G", 3) == 0) le = false;
+      else return;
+    }
 
-    if (advertisedDevice->haveServiceUUID() && advertisedDevice->isAdvertisingService(bmeServiceUUID)) {
-      std::string deviceName = advertisedDevice->getName(); // common name
-      std::string deviceAddrStr = advertisedDevice->getAddress().toString(); // mac
-
-      if (deviceName.length() < 3) return;
-      std::string devicePrefix = deviceName.substr(0,3);
-
-      bool doBLEConnect;
-
-      if (devicePrefix == "V1C") {
-        Serial.printf("%s found: %s | MAC: %s\n", devicePrefix.c_str(), deviceName.c_str(), deviceAddrStr.c_str());
-        v1le = true;
-        if (settings.useV1LE && !bt_connected) {
-          Serial.println("Attempting to connect to V1C LE");
-          NimBLEDevice::getScan()->stop();
-          doBLEConnect = true;
-
-          pClient = NimBLEDevice::getClientByPeerAddress(advertisedDevice->getAddress());
-          if (!pClient) {
-            pClient = NimBLEDevice::createClient(advertisedDevice->getAddress());
-          }
-        } else {
-          Serial.println("use V1C LE set to false; skipping...");
-        }
-      }
-      else if (devicePrefix == "V1G") {
-        Serial.printf("%s found: %s | MAC: %s\n", devicePrefix.c_str(), deviceName.c_str(), deviceAddrStr.c_str());
-        if (!settings.useV1LE && !bt_connected) {
-          Serial.println("Attempting to connect to V1G");
-          NimBLEDevice::getScan()->stop();
-          doBLEConnect = true;
-
-          pClient = NimBLEDevice::getClientByPeerAddress(advertisedDevice->getAddress());
-          if (!pClient) {
-            pClient = NimBLEDevice::createClient(advertisedDevice->getAddress());
-            if (!pClient) {
-              Serial.printf("Failed to create client\n");
-              return;
-            }
-          }
-        }
-      }
+    Serial.printf("%s found | MAC: %s\n", le ? "V1C" : "V1G", advertisedDevice->getAddress().toString().c_str());
+    if (le != settings.useV1LE) {
+      Serial.println(le ? "use V1C LE set to false; skipping..." : "use V1C LE set; skipping V1G...");
+      return;
+    }
 
-      if (doBLEConnect && pClient) {
-        if (!pClient->connect(true, true, false)) {
-          Serial.println("Failed to connect, deleting client...");
-          NimBLEDevice::deleteClient(pClient);
-          pClient = nullptr;
-          return;
-        }
-        pClient->setClientCallbacks(&clientCallbacks, false);
-      }
+    Serial.printf("Attempting to connect to %s\n", le ? "V1C LE" : "V1G");
+    v1le = le;
+    v1LinkScanMatch();
+    NimBLEDevice::getScan()->stop();
+    if (!connectV1(advertisedDevice->getAddress(), true)) {
+      v1LinkConnectFailed();
     }
   }
 
   void onScanEnd(const NimBLEScanResults& results, int reason) override {
-      bt_connected = false;
-      NimBLEDevice::getScan()->start(scanTimeMs);
+    v1LinkScanEnded();
   }
 } scanCallbacks;
 
 class CommandWriteCallback : public NimBLECharacteristicCallbacks {
   void onWrite(NimBLECharacteristic* pCharacteristic, NimBLEConnInfo& connInfo) override {
-    std::string cmd = pCharacteristic->getValue();
-
-    if (clientWriteCharacteristic) {
-      if (clientWriteCharacteristic->writeValue(cmd)) {
-        /*
-        Serial.print("Command forwarded to V1G2: ");
-        for (char c : cmd) Serial.printf("%02X ", (uint8_t)c);
-        Serial.println();
-        */
-      } else {
-        Serial.println("Failed to forward command.");
-      }
-    } else {
-      Serial.println("Write characteristic not ready.");
+    NimBLEAttValue cmd = pCharacteristic->getValue();
+
+    if (!proxyQueueCommand(connInfo.getConnHandle(), cmd.data(), cmd.length())) {
+      Serial.printf("Command from client %d rejected, queue full\n", connInfo.getConnHandle());
     }
   }
 };
@@ -223,11 +225,25 @@ class ProxyServerCallbacks : public NimBLEServerCallbacks {
       connInfo.isAuthenticated() ? "yes" : "no",
       connInfo.isBonded() ? "yes" : "no"
     ); 
+
+    ble_gap_set_data_len(connInfo.getConnHandle(), BLE_DLE_TX_OCTETS, BLE_DLE_TX_TIME);
+
+    if (!proxyAddClient(connInfo.getConnHandle())) {
+      Serial.println("Proxy client limit reached, disconnecting");
+      pServer->disconnect(connInfo.getConnHandle());
+      return;
+    }
     proxyConnected = true;
+
+    // keep advertising so a second app (e.g. a logger next to the companion) can join
+    if (bt_connected && proxyClientCount() < PROXY_MAX_CLIENTS) {
+      NimBLEDevice::startAdvertising();
+    }
   }
 
   void onDisconnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo, int reason) override {
-    proxyConnected = false;
+    proxyRemoveClient(connInfo.getConnHandle());
+    proxyConnected = proxyClientCount() > 0;
 
     Serial.printf("BLE client disconnected. Reason=0x%02X (%d)\n", reason, reason);
     if (bt_connected) {
@@ -237,8 +253,8 @@ class ProxyServerCallbacks : public NimBLEServerCallbacks {
     }
   }
 
-  void onMTUChange(uint16_t MTU, ble_gap_conn_desc* desc) {
-    Serial.printf("MTU Changed to: %d for connection %d\n", MTU, desc->conn_handle);
+  void onMTUChange(uint16_t MTU, NimBLEConnInfo& connInfo) override {
+    Serial.printf("MTU Changed to: %d for connection %d\n", MTU, connInfo.getConnHandle());
   }
 };
 
@@ -247,16 +263,22 @@ class NotifyCharCallbacks : public NimBLECharacteristicCallbacks {
                    NimBLEConnInfo& connInfo,
                    uint16_t subValue) override {
 
-    notifySubscribed = (subValue & 0x01);
+    bool notify = (subValue & 0x01);
+    if (pChar == pAlertNotifyChar) {
+      proxySetSubscriber(connInfo.getConnHandle(), notify);
+    } else if (pChar == pAlertNotifyLongChar) {
+      proxySetLongSubscriber(connInfo.getConnHandle(), notify);
+    }
 
     Serial.printf(
       "Client SUBSCRIBE event\n"
       "  Char UUID: %s\n"
       "  subValue: 0x%02X\n"
+      "  Notify: %s\n"
       "  Address: %s\n",
       pChar->getUUID().toString().c_str(),
       subValue,
-      notifySubscribed ? "yes" : "no",
+      notify ? "yes" : "no",
       connInfo.getAddress().toString().c_str()
     );
   }
@@ -265,16 +287,13 @@ class NotifyCharCallbacks : public NimBLECharacteristicCallbacks {
 static void notifyDisplayCallbackv2(NimBLERemoteCharacteristic* pCharacteristic, uint8_t* pData, size_t length, bool isNotify) {
   if (!pData) return;
 
-  if (pAlertNotifyChar && settings.proxyBLE) {
-    if (xSemaphoreTake(bleNotifyMutex, pdMS_TO_TICKS(50))) {
-      pAlertNotifyChar->setValue(pData, length);
-      if (notifySubscribed) {
-        pAlertNotifyChar->notify();
-      }
-      xSemaphoreGive(bleNotifyMutex);
-    }
+  // forward before any decode work so the companion app sees the packet first
+  if (settings.proxyBLE) {
+    proxyForward(pData, length);
   }
 
+  if (!v1AcceptFrame(pData, length)) return;
+
   bool hasAlerts = false;
   uint8_t packetId = pData[3];
 
@@ -296,8 +315,7 @@ static void notifyDisplayCallbackv2(NimBLERemoteCharacteristic* pCharacteristic,
   if (hasAlerts || needsMode) {
     //latestRawData.assign(pData, pData + length);
     newDataAvailable = true;
-    std::vector<uint8_t> packetCopy(pData, pData + length);
-    PacketDecoder decoder(packetCopy);
+    PacketDecoder decoder(pData, length);
     decoder.decode_v2(settings.lowSpeedThreshold, currentSpeed);
   }
 }
@@ -334,19 +352,12 @@ void displayReader(NimBLEClient* pClient) {
     pDesc->writeValue((uint8_t*)notificationOn, 2, true);
   }
   
-  vTaskDelay(pdMS_TO_TICKS(50));
-  
   if (settings.turnOffDisplay) {
     uint8_t value = settings.onlyDisplayBTIcon ? 0x01 : 0x00;
-    clientWriteCharacteristic->writeValue(
-        (uint8_t*)Packet::reqTurnOffMainDisplay(value), 8, false
-    );
-    vTaskDelay(pdMS_TO_TICKS(50));
+    v1Send(Packet::reqTurnOffMainDisplay(value), V1_CMD_USER);
   }
   
-  clientWriteCharacteristic->writeValue(
-    (uint8_t*)Packet::reqStartAlertData(), 7, false
-  );
+  v1Send(Packet::reqStartAlertData(), V1_CMD_USER);
   
   if (settings.proxyBLE) {
     onProxyReady();
@@ -390,57 +401,44 @@ void queryDeviceInfo(NimBLEClient* pClient) {
     }
   }
 
+// All writes to the V1 go through the command scheduler (v1_cmd.cpp); these only queue.
 void requestSerialNumber() {
-      clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqSerialNumber(), 7, false);
-      delay(10);
-  }
-  
+  v1Send(Packet::reqSerialNumber(), V1_CMD_POLL);
+}
+
 void requestVersion() {
-    clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqVersion(), 7, false);
-    delay(10);
+  v1Send(Packet::reqVersion(), V1_CMD_POLL);
 }
 
 void requestVolume() {
-  if (xSemaphoreTake(bleMutex, pdMS_TO_TICKS(100))) {
-    clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqCurrentVolume(), 7, false);
-    vTaskDelay(10);
-    xSemaphoreGive(bleMutex);
-  }
+  v1Send(Packet::reqCurrentVolume(), V1_CMD_POLL);
 }
 
 void requestUserBytes() {
-    clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqUserBytes(), 7, false);
-    vTaskDelay(10);
+  v1Send(Packet::reqUserBytes(), V1_CMD_POLL);
 }
 
 void requestSweepSections() {
-  if (bt_connected && clientWriteCharacteristic) {
-    clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqSweepSections(), 7, false);
-    vTaskDelay(10);
+  if (bt_connected) {
+    v1Send(Packet::reqSweepSections(), V1_CMD_POLL);
   }
 }
 
 void requestMaxSweepIndex() {
-  if (bt_connected && clientWriteCharacteristic) {
-    clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqMaxSweepIndex(), 7, false);
-    vTaskDelay(10);
+  if (bt_connected) {
+    v1Send(Packet::reqMaxSweepIndex(), V1_CMD_POLL);
   }
 }
 
 void requestAllSweepDefinitions() {
-  if (bt_connected && clientWriteCharacteristic) {
-    clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqAllSweepDefinitions(), 7, false);
-    vTaskDelay(10);
+  if (bt_connected) {
+    v1Send(Packet::reqAllSweepDefinitions(), V1_CMD_POLL);
   }
 }
 
 void reqBatteryVoltage() {
-  if (bt_connected && clientWriteCharacteristic && !alertPresent) {
-    if (xSemaphoreTake(bleMutex, pdMS_TO_TICKS(100))) {
-      clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqBatteryVoltage(), 7, false);
-      vTaskDelay(10);
-      xSemaphoreGive(bleMutex);
-    }
+  if (bt_connected && !alertPresent) {
+    v1Send(Packet::reqBatteryVoltage(), V1_CMD_POLL);
   }
 }
 
@@ -454,12 +452,8 @@ void batteryTask(void *p) {
 }
 
 void reqVolume() {
-  if (bt_connected && clientWriteCharacteristic && !alertPresent) {
-    if (xSemaphoreTake(bleMutex, pdMS_TO_TICKS(100))) {
-      clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqCurrentVolume(), 7, false);
-      vTaskDelay(10);
-      xSemaphoreGive(bleMutex);
-    }
+  if (bt_connected && !alertPresent) {
+    v1Send(Packet::reqCurrentVolume(), V1_CMD_POLL);
   }
 }
 
@@ -473,19 +467,19 @@ void volumeTask(void *p) {
 }
 
 void requestMute() {
-  if (!settings.displayTest && clientWriteCharacteristic && bt_connected) {
-    clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqMuteOn(), 7, false);
+  if (!settings.displayTest && bt_connected) {
+    v1Send(Packet::reqMuteOn(), V1_CMD_MUTE);
   }
 }
 
 void reqMuteOff() {
-  if (!settings.displayTest && clientWriteCharacteristic && bt_connected) {
-    clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqMuteOff(), 7, false);
+  if (!settings.displayTest && bt_connected) {
+    v1Send(Packet::reqMuteOff(), V1_CMD_MUTE);
   }
 }
 
 void initBLE() {
-  bleMutex = xSemaphoreCreateMutex();
+  startV1CmdScheduler();
   if (settings.proxyBLE) {
     Serial.println("initializing as BLE Proxy");
     NimBLEDevice::init("V1 Proxy");
@@ -498,12 +492,17 @@ void initBLE() {
     NimBLEDevice::setPower(ESP_PWR_LVL_P9);
   }
 
+  // larger ATT MTU and link-layer packets, so a long response or a proxy batch
+  // isn't split into 27-byte fragments
+  NimBLEDevice::setMTU(BLE_PREFERRED_MTU);
+  ble_gap_write_sugg_def_data_len(BLE_DLE_TX_OCTETS, BLE_DLE_TX_TIME);
+
   NimBLEScan* pScan = NimBLEDevice::getScan();
   pScan->setScanCallbacks(&scanCallbacks);
   pScan->setInterval(100);
   pScan->setWindow(75);
-  pScan->setActiveScan(true);
-  pScan->start(scanTimeMs);
+  pScan->setActiveScan(false);
+  startV1Link();
 }
 
 void initBLEServer() {
@@ -552,6 +551,7 @@ void initBLEServer() {
   pCommandWriteLongChar->setCallbacks(writeCallbacks);
   pCommandWritewithout->setCallbacks(writeCallbacks);
   pRadarService->start();
+  proxyInit(pAlertNotifyChar, pAlertNotifyLongChar);
 
   //pServer->setCallbacks(new ProxyServerCallbacks());
 
@@ -3,6 +3,10 @@
 
 #include <NimBLEDevice.h>
 
+#define BLE_PREFERRED_MTU 247        // one ATT PDU (+4 byte L2CAP header) fills a 251-octet DLE packet
+#define BLE_DLE_TX_OCTETS 251         // LE Data Length Extension: one 247-byte MTU per LL packet
+#define BLE_DLE_TX_TIME 2120          // us, (251 + 14) * 8 on the 1M PHY
+
 extern NimBLEClient* pClient;
 extern NimBLERemoteCharacteristic* clientWriteCharacteristic;
 
@@ -26,6 +30,7 @@ void requestMute();
 void reqMuteOff();
 void queryDeviceInfo(NimBLEClient* pClient);
 void displayReader(NimBLEClient* pClient);
+bool connectV1(const NimBLEAddress& address, bool async);
 void onProxyReady();
 
 void volumeTask(void *p);
@@ -0,0 +1,79 @@
+#include "brightness.h"
+#include "v1_config.h"
+#include "lvgl.h"
+
+static lv_timer_t *brightnessTimer = nullptr;
+static volatile int16_t pendingBrightness = -1;
+
+// 0..1 ease between edge0 and edge1; only used on the twilight ramps
+static float smoothstep(time_t edge0, time_t edge1, time_t t)
+{
+  if (t <= edge0) return 0.0f;
+  if (t >= edge1) return 1.0f;
+  float x = static_cast<float>(t - edge0) / static_cast<float>(edge1 - edge0);
+  return x * x * (3.0f - 2.0f * x);
+}
+
+// Night level until civil dawn, ramp up to full at sunrise, hold through the day,
+// ramp back down between sunset and civil dusk. Uses the cached daily table only.
+uint8_t solarBrightness(time_t utc, const SolarDay &day, uint8_t dayLevel, uint8_t nightLevel)
+{
+  if (day.alwaysUp) return dayLevel;
+  if (day.alwaysDown) return nightLevel;
+
+  float level;
+  if (utc < day.solarNoon) {
+    level = smoothstep(day.civilDawn, day.sunrise, utc);
+  } else {
+    level = 1.0f - smoothstep(day.sunset, day.civilDusk, utc);
+  }
+  return nightLevel + static_cast<uint8_t>(level * (dayLevel - nightLevel) + 0.5f);
+}
+
+void applyAutoBrightness()
+{
+  if (!settings.autoBrightness || !gpsAvailable) return;
+  if (xSemaphoreTake(gpsDataMutex, 0) != pdTRUE) return;
+
+  time_t utc = gpsData.rawTime;
+  double lat = gpsData.latitude;
+  double lon = gpsData.longitude;
+  xSemaphoreGive(gpsDataMutex);
+
+  SolarDay day;
+  if (utc == 0 || !getSolarDay(utc, lat, lon, day)) return;
+
+  uint8_t nightLevel = min(settings.nightBrightness, settings.brightness);
+  uint8_t level = solarBrightness(utc, day, settings.brightness, nightLevel);
+  if (level != amoled.getBrightness()) {
+    Serial.printf("Auto-brightness: %u -> %u\n", amoled.getBrightness(), level);
+    amoled.setBrightness(level);
+  }
+}
+
+static void brightness_timer_cb(lv_timer_t *timer)
+{
+  applyAutoBrightness();
+}
+
+// runs on the LVGL timer so panel commands never interleave with a flush
+void initAutoBrightness()
+{
+  if (brightnessTimer) return;
+  brightnessTimer = lv_timer_create(brightness_timer_cb, AUTO_BRIGHTNESS_PERIOD_MS, NULL);
+}
+
+// Panel commands share the bus with the async LVGL flush, so callers outside the
+// UI loop (e.g. the web server) hand the level over instead of writing it directly.
+void requestBrightness(uint8_t level)
+{
+  pendingBrightness = level;
+}
+
+void applyPendingBrightness()
+{
+  int16_t level = pendingBrightness;
+  if (level < 0) return;
+  pendingBrightness = -1;
+  amoled.setBrightness(static_cast<uint8_t>(level));
+}
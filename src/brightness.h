@@ -0,0 +1,16 @@
+#ifndef BRIGHTNESS_H
+#define BRIGHTNESS_H
+
+#include <Arduino.h>
+#include "v1_time.h"
+
+#define AUTO_BRIGHTNESS_PERIOD_MS 30000
+#define NIGHT_BRIGHTNESS_MIN 10           // lowest night level accepted; 0 blanks the panel
+
+uint8_t solarBrightness(time_t utc, const SolarDay &day, uint8_t dayLevel, uint8_t nightLevel);
+void initAutoBrightness();
+void applyAutoBrightness();
+void requestBrightness(uint8_t level);
+void applyPendingBrightness();
+
+#endif // BRIGHTNESS_H
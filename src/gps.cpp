@@ -1,12 +1,12 @@
 #include <Arduino.h>
 #include "gps.h"
 #include "v1_config.h"
+#include "v1_time.h"
 #include <TinyGPS++.h>
 
 HardwareSerial gpsSerial(1);
 TinyGPSPlus gps;
 GPSData gpsData;
-Timezone tz;
 uint8_t currentSpeed = 0;
 unsigned long lastValidGPSUpdate = 0;
 bool firstFixRecorded;
@@ -17,22 +17,15 @@ void formatLocalTime(TinyGPSPlus &gps, char *buffer, size_t bufSize)
 {
   if (!gps.time.isValid())
   {
-    snprintf(buffer, sizeof(bufSize), "00:00:00");
+    snprintf(buffer, bufSize, "00:00:00");
     return;
   }
 
-  tmElements_t tm;
-  tm.Hour = gps.time.hour();
-  tm.Minute = gps.time.minute();
-  tm.Second = gps.time.second();
-  tm.Day = gps.date.day();
-  tm.Month = gps.date.month();
-  tm.Year = gps.date.year() - 1970;
+  time_t localTime = utcToLocal(convertToUnixTimestamp(gps));
+  int year, month, day, hour, minute, second;
+  civilFromEpoch(localTime, year, month, day, hour, minute, second);
 
-  time_t utcTime = makeTime(tm);
-  time_t localTime = tz.tzTime(utcTime, LOCAL_TIME);
-
-  snprintf(buffer, bufSize, "%02d:%02d:%02d", hour(localTime), minute(localTime), second(localTime));
+  snprintf(buffer, bufSize, "%02d:%02d:%02d", hour, minute, second);
 }
 
 void formatLocalDate(TinyGPSPlus &gps, char *buffer, size_t bufSize)
@@ -43,37 +36,17 @@ void formatLocalDate(TinyGPSPlus &gps, char *buffer, size_t bufSize)
     return;
   }
 
-  tmElements_t tm;
-  tm.Hour   = gps.time.hour();
-  tm.Minute = gps.time.minute();
-  tm.Second = gps.time.second();
-  tm.Day    = gps.date.day();
-  tm.Month  = gps.date.month();
-  tm.Year   = gps.date.year() - 1970;
-
-  time_t utcTime = makeTime(tm);
-  time_t localTime = tz.tzTime(utcTime);
+  time_t localTime = utcToLocal(convertToUnixTimestamp(gps));
+  int year, month, day, hour, minute, second;
+  civilFromEpoch(localTime, year, month, day, hour, minute, second);
 
-  snprintf(buffer, bufSize, "%02d/%02d/%04d", month(localTime), day(localTime), year(localTime));
+  snprintf(buffer, bufSize, "%02d/%02d/%04d", month, day, year);
 }
 
 uint32_t convertToUnixTimestamp(TinyGPSPlus &gps)
 {
-  TinyGPSDate gpsDate = gps.date;
-  TinyGPSTime gpsTime = gps.time;
-
-  tm timeInfo = {};
-
-  timeInfo.tm_year = gpsDate.year() - 1900;
-  timeInfo.tm_mon = gpsDate.month() - 1;
-  timeInfo.tm_mday = gpsDate.day();
-  timeInfo.tm_hour = gpsTime.hour();
-  timeInfo.tm_min = gpsTime.minute();
-  timeInfo.tm_sec = gpsTime.second();
-
-  uint32_t unixTimestamp = mktime(&timeInfo);
-
-  return unixTimestamp;
+  return makeUtcTime(gps.date.year(), gps.date.month(), gps.date.day(),
+                     gps.time.hour(), gps.time.minute(), gps.time.second());
 }
 
 void gpsTask(void *parameter)
@@ -96,6 +69,12 @@ void gpsTask(void *parameter)
           Serial.printf("Time to first GPS fix: %lu ms\n", gpsData.ttffMs);
         }
 
+        // format outside the mutex; the tz offset is cached so this is just an add
+        char dateBuf[11];
+        formatLocalDate(gps, dateBuf, sizeof(dateBuf));
+        char timeBuf[16];
+        formatLocalTime(gps, timeBuf, sizeof(timeBuf));
+
         if (xSemaphoreTake(gpsDataMutex, portMAX_DELAY)) {
           gpsData.latitude = gps.location.lat();
           gpsData.longitude = gps.location.lng();
@@ -103,12 +82,7 @@ void gpsTask(void *parameter)
           gpsData.course = gps.course.deg();
           gpsData.rawTime = convertToUnixTimestamp(gps);
 
-          char dateBuf[11];
-          formatLocalDate(gps, dateBuf, sizeof(dateBuf));
           strncpy(gpsData.date, dateBuf, sizeof(gpsData.date));
-          
-          char timeBuf[16];
-          formatLocalTime(gps, timeBuf, sizeof(timeBuf));
           strncpy(gpsData.time, timeBuf, sizeof(gpsData.time));
           gpsData.time[sizeof(gpsData.time) - 1] = '\0';
 
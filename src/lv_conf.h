@@ -323,7 +323,9 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #define LV_ATTRIBUTE_TIMER_HANDLER
 
 /*Define a custom attribute to `lv_disp_flush_ready` function*/
-#define LV_ATTRIBUTE_FLUSH_READY
+/*Called from the SPI post-transaction ISR (see LV_Helper.cpp), so it must live in IRAM*/
+#include "esp_attr.h"
+#define LV_ATTRIBUTE_FLUSH_READY IRAM_ATTR
 
 /*Required alignment size for buffers*/
 #define LV_ATTRIBUTE_MEM_ALIGN_SIZE 1
@@ -0,0 +1,412 @@
+#include "proxy.h"
+#include "ble.h"
+#include "v1_config.h"
+#include "v1_cmd.h"
+#include "v1_proto.h"
+
+#if defined(CONFIG_NIMBLE_CPP_IDF)
+#include "host/ble_hs.h"
+#else
+#include "nimble/nimble/host/include/host/ble_hs.h"
+#endif
+
+struct ProxyPacket {
+  uint8_t length;
+  uint32_t receivedUs;
+  uint8_t data[PROXY_MAX_PACKET];
+};
+
+// Frames taken off the queue for one notification on the long characteristic; kept
+// until the host accepts it
+struct ProxyBatch {
+  uint16_t length;
+  uint8_t frames;
+  uint32_t receivedUs;
+  uint8_t data[PROXY_BATCH_MAX];
+};
+
+struct ProxyClient {
+  bool active;
+  bool longSubscribed;
+  volatile bool batchClosed;    // the newest queued frame ends an alert table (or isn't one)
+  QueueHandle_t notifyQueue;
+  QueueHandle_t cmdQueue;
+  ProxyBatch batch;
+  ProxyLinkStats stats;
+};
+
+static NimBLECharacteristic *proxyNotifyChar = nullptr;
+static NimBLECharacteristic *proxyLongChar = nullptr;
+static uint16_t notifyAttrHandle = 0;
+static uint16_t longAttrHandle = 0;
+static TaskHandle_t proxyTaskHandle = NULL;
+
+// slot bookkeeping and stats; the queues themselves are thread safe
+static portMUX_TYPE proxyMux = portMUX_INITIALIZER_UNLOCKED;
+static ProxyClient clients[PROXY_MAX_CLIENTS];
+
+static ProxyClient *findClient(uint16_t connHandle)
+{
+  for (auto &client : clients) {
+    if (client.active && client.stats.connHandle == connHandle) return &client;
+  }
+  return nullptr;
+}
+
+bool proxyAddClient(uint16_t connHandle)
+{
+  bool added = false;
+  // ble_att_mtu() takes the host lock, so it can't be called under the spinlock
+  uint16_t mtu = ble_att_mtu(connHandle);
+  portENTER_CRITICAL(&proxyMux);
+  for (auto &client : clients) {
+    if (!client.active) {
+      client.stats = {};
+      client.stats.connHandle = connHandle;
+      client.stats.mtu = mtu;
+      client.longSubscribed = false;
+      client.batchClosed = true;
+      client.batch.length = 0;
+      client.active = true;
+      added = true;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&proxyMux);
+  return added;
+}
+
+void proxyRemoveClient(uint16_t connHandle)
+{
+  portENTER_CRITICAL(&proxyMux);
+  ProxyClient *client = findClient(connHandle);
+  if (client) {
+    client->active = false;
+    client->stats.subscribed = false;
+    client->longSubscribed = false;
+  }
+  portEXIT_CRITICAL(&proxyMux);
+
+  if (client) {
+    xQueueReset(client->notifyQueue);
+    xQueueReset(client->cmdQueue);
+  }
+}
+
+uint8_t proxyClientCount()
+{
+  uint8_t count = 0;
+  for (auto &client : clients) {
+    if (client.active) count++;
+  }
+  return count;
+}
+
+// attribute handles are assigned when the GATT server starts, so look them up on
+// the first subscription
+static void lookupHandles()
+{
+  if (proxyNotifyChar && notifyAttrHandle == 0) {
+    notifyAttrHandle = proxyNotifyChar->getHandle();
+  }
+  if (proxyLongChar && longAttrHandle == 0) {
+    longAttrHandle = proxyLongChar->getHandle();
+  }
+}
+
+void proxySetSubscriber(uint16_t connHandle, bool subscribed)
+{
+  lookupHandles();
+
+  portENTER_CRITICAL(&proxyMux);
+  ProxyClient *client = findClient(connHandle);
+  if (client) client->stats.subscribed = subscribed;
+  portEXIT_CRITICAL(&proxyMux);
+}
+
+void proxySetLongSubscriber(uint16_t connHandle, bool subscribed)
+{
+  lookupHandles();
+
+  portENTER_CRITICAL(&proxyMux);
+  ProxyClient *client = findClient(connHandle);
+  if (client) client->longSubscribed = subscribed;
+  portEXIT_CRITICAL(&proxyMux);
+}
+
+// Apps that read the long characteristic get the V1 frames concatenated into as few
+// notifications as the MTU allows. Each frame keeps its 0xAA...0xAB framing, so the
+// app splits them the same way it splits a long V1 response.
+static inline bool isBatching(const ProxyClient &client)
+{
+  return settings.proxyBatch && client.longSubscribed && longAttrHandle != 0;
+}
+
+uint8_t getProxyStats(ProxyLinkStats *out, uint8_t max)
+{
+  uint8_t count = 0;
+  uint16_t mtu[PROXY_MAX_CLIENTS];
+  for (uint8_t i = 0; i < PROXY_MAX_CLIENTS; i++) {
+    mtu[i] = clients[i].active ? ble_att_mtu(clients[i].stats.connHandle) : 0;
+  }
+
+  portENTER_CRITICAL(&proxyMux);
+  for (uint8_t i = 0; i < PROXY_MAX_CLIENTS; i++) {
+    ProxyClient &client = clients[i];
+    if (!client.active || count >= max) continue;
+    client.stats.batching = isBatching(client);
+    if (mtu[i]) client.stats.mtu = mtu[i];
+    out[count++] = client.stats;
+  }
+  portEXIT_CRITICAL(&proxyMux);
+  return count;
+}
+
+static bool sendNotify(ProxyClient &client, uint16_t attrHandle, const uint8_t *data, size_t length,
+                       uint32_t receivedUs, uint8_t frames = 1)
+{
+  struct os_mbuf *om = ble_hs_mbuf_from_flat(data, length);
+  // ble_gatts_notify_custom consumes om on success and failure alike
+  if (!om || ble_gatts_notify_custom(client.stats.connHandle, attrHandle, om) != 0) {
+    return false;
+  }
+
+  uint32_t us = micros() - receivedUs;
+  portENTER_CRITICAL(&proxyMux);
+  client.stats.forwarded += frames;
+  if (attrHandle == longAttrHandle) {
+    client.stats.batches++;
+    client.stats.batchedFrames += frames;
+  }
+  client.stats.lastUs = us;
+  client.stats.totalUs += (uint64_t)us * frames;   // latency of the oldest frame in a batch
+  if (us > client.stats.maxUs) client.stats.maxUs = us;
+  portEXIT_CRITICAL(&proxyMux);
+  return true;
+}
+
+static void countDrop(ProxyClient &client)
+{
+  portENTER_CRITICAL(&proxyMux);
+  client.stats.dropped++;
+  portEXIT_CRITICAL(&proxyMux);
+}
+
+// An alert table arrives as one 0x43 frame per alert; all but the last are worth
+// holding back for a batch
+static inline bool isOpenAlertTable(const uint8_t *data, size_t length)
+{
+  if (length < 6 || data[3] != PACKET_ID_RESPALERTDATA) return false;
+  uint8_t index = data[5] >> 4;
+  uint8_t count = data[5] & 0x0F;
+  return index < count;
+}
+
+// Runs in the NimBLE host task straight from the V1 notify callback, before any
+// decoding. Each subscribed client gets the packet directly from the receive buffer
+// unless its link is backed up; then it joins that client's queue behind the older
+// packets, so one slow app never holds up the others or reorders its own stream.
+// Batching clients always go through the queue.
+void proxyForward(const uint8_t *data, size_t length)
+{
+  if (notifyAttrHandle == 0) return;
+  uint32_t receivedUs = micros();
+  bool wake = false;
+  bool closesBatch = !isOpenAlertTable(data, length);
+
+  for (auto &client : clients) {
+    bool batching = isBatching(client);
+    if (!client.active || (!client.stats.subscribed && !batching)) continue;
+
+    if (!batching && client.batch.length == 0 && uxQueueMessagesWaiting(client.notifyQueue) == 0 &&
+        sendNotify(client, notifyAttrHandle, data, length, receivedUs)) {
+      continue;
+    }
+
+    ProxyPacket packet;
+    if (length > sizeof(packet.data)) {
+      countDrop(client);
+      continue;
+    }
+    packet.length = length;
+    packet.receivedUs = receivedUs;
+    memcpy(packet.data, data, length);
+    if (xQueueSend(client.notifyQueue, &packet, 0) == pdTRUE) {
+      client.batchClosed = closesBatch;
+      if (!batching) {
+        portENTER_CRITICAL(&proxyMux);
+        client.stats.queued++;
+        portEXIT_CRITICAL(&proxyMux);
+      }
+      wake = true;
+    } else {
+      countDrop(client);
+    }
+  }
+
+  if (wake) xTaskNotifyGive(proxyTaskHandle);
+}
+
+// Client writes are queued per connection and sent to the V1 by the proxy task, so
+// they reach it as one ordered stream. A full queue rejects the write, as does anything
+// too short to be a V1 frame.
+bool proxyQueueCommand(uint16_t connHandle, const uint8_t *data, size_t length)
+{
+  portENTER_CRITICAL(&proxyMux);
+  ProxyClient *client = findClient(connHandle);
+  portEXIT_CRITICAL(&proxyMux);
+  if (!client) return false;
+
+  ProxyPacket packet;
+  bool queued = false;
+  if (length >= V1_FRAME_OVERHEAD - 1 && length <= sizeof(packet.data)) {
+    packet.length = length;
+    packet.receivedUs = micros();
+    memcpy(packet.data, data, length);
+    queued = xQueueSend(client->cmdQueue, &packet, 0) == pdTRUE;
+  }
+
+  if (queued) {
+    xTaskNotifyGive(proxyTaskHandle);
+  } else {
+    portENTER_CRITICAL(&proxyMux);
+    client->stats.commandsRejected++;
+    portEXIT_CRITICAL(&proxyMux);
+  }
+  return queued;
+}
+
+// Sends a client's backed-up notifications oldest first. Peek before removing, so
+// proxyForward keeps queueing behind a packet that is still being sent.
+static bool drainNotifications(ProxyClient &client)
+{
+  ProxyPacket packet;
+  while (xQueuePeek(client.notifyQueue, &packet, 0) == pdTRUE) {
+    if (!client.active) return false;
+    if (!sendNotify(client, notifyAttrHandle, packet.data, packet.length, packet.receivedUs)) return true;
+    xQueueReceive(client.notifyQueue, &packet, 0);
+  }
+  return false;
+}
+
+// Packs queued frames into the client's batch until the next one would not fit the
+// link's MTU. A frame that can't fit even an empty batch is dropped.
+static void fillBatch(ProxyClient &client)
+{
+  ProxyBatch &batch = client.batch;
+  uint16_t mtu = ble_att_mtu(client.stats.connHandle);
+  size_t limit = mtu > 3 ? mtu - 3 : 0;
+  if (limit > PROXY_BATCH_MAX) limit = PROXY_BATCH_MAX;
+  ProxyPacket packet;
+
+  while (xQueuePeek(client.notifyQueue, &packet, 0) == pdTRUE) {
+    if (batch.length + packet.length > limit) {
+      if (batch.length > 0) break;
+      countDrop(client);
+    } else {
+      if (batch.length == 0) batch.receivedUs = packet.receivedUs;
+      memcpy(batch.data + batch.length, packet.data, packet.length);
+      batch.length += packet.length;
+      batch.frames++;
+    }
+    xQueueReceive(client.notifyQueue, &packet, 0);
+  }
+}
+
+// Batches go out once the alert table in the queue is complete, or when its oldest
+// frame has waited PROXY_BATCH_HOLD_MS for a table frame that may never come.
+static bool drainBatches(ProxyClient &client)
+{
+  for (;;) {
+    if (!client.active) return false;
+
+    if (client.batch.length == 0) {
+      // proxyBatch was switched off while a batch was pending
+      if (!isBatching(client)) return drainNotifications(client);
+
+      ProxyPacket head;
+      if (xQueuePeek(client.notifyQueue, &head, 0) != pdTRUE) return false;
+      if (!client.batchClosed && uxQueueSpacesAvailable(client.notifyQueue) > 0 &&
+          micros() - head.receivedUs < PROXY_BATCH_HOLD_MS * 1000) {
+        return true;
+      }
+
+      client.batch.frames = 0;
+      fillBatch(client);
+      if (client.batch.length == 0) continue;
+    }
+
+    if (!sendNotify(client, longAttrHandle, client.batch.data, client.batch.length,
+                    client.batch.receivedUs, client.batch.frames)) {
+      return true;
+    }
+    client.batch.length = 0;
+  }
+}
+
+// Hands client commands to the V1 command scheduler one client per turn. A command
+// the scheduler can't take yet stays at the head of its queue and that client keeps
+// its turn, so backpressure reaches the apps instead of dropping their writes.
+static bool forwardCommands(uint8_t &nextClient)
+{
+  for (uint8_t n = 0; n < PROXY_MAX_CLIENTS; n++) {
+    ProxyClient &client = clients[nextClient];
+    ProxyPacket packet;
+    if (client.active && xQueuePeek(client.cmdQueue, &packet, 0) == pdTRUE) {
+      if (!bt_connected) {
+        xQueueReset(client.cmdQueue);
+        Serial.println("Write characteristic not ready.");
+      } else {
+        V1SendResult result = v1SendRaw(packet.data, packet.length,
+                                        isMuteCommand(packet.data, packet.length) ? V1_CMD_MUTE : V1_CMD_USER);
+        if (result == V1_SEND_FULL) return true;
+
+        // queued, or one the scheduler will never take; either way it leaves the head
+        xQueueReceive(client.cmdQueue, &packet, 0);
+        portENTER_CRITICAL(&proxyMux);
+        if (result == V1_SEND_QUEUED) client.stats.commands++;
+        else client.stats.commandsRejected++;
+        portEXIT_CRITICAL(&proxyMux);
+      }
+    }
+    nextClient = (nextClient + 1) % PROXY_MAX_CLIENTS;
+  }
+
+  for (auto &client : clients) {
+    if (client.active && uxQueueMessagesWaiting(client.cmdQueue) > 0) return true;
+  }
+  return false;
+}
+
+static void proxyTask(void *pvParameters)
+{
+  uint8_t nextClient = 0;
+  bool backlog = false;
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, backlog ? pdMS_TO_TICKS(PROXY_RETRY_MS) : portMAX_DELAY);
+
+    backlog = false;
+    for (auto &client : clients) {
+      if (!client.active) continue;
+      if (isBatching(client) || client.batch.length > 0) {
+        if (drainBatches(client)) backlog = true;
+      } else if (drainNotifications(client)) {
+        backlog = true;
+      }
+    }
+    if (forwardCommands(nextClient)) backlog = true;
+  }
+}
+
+void proxyInit(NimBLECharacteristic *notifyChar, NimBLECharacteristic *longChar)
+{
+  proxyNotifyChar = notifyChar;
+  proxyLongChar = longChar;
+  for (auto &client : clients) {
+    client.notifyQueue = xQueueCreate(PROXY_NOTIFY_QUEUE_LEN, sizeof(ProxyPacket));
+    client.cmdQueue = xQueueCreate(PROXY_CMD_QUEUE_LEN, sizeof(ProxyPacket));
+  }
+  xTaskCreatePinnedToCore(proxyTask, "ProxyTask", PROXY_TASK_STACK, NULL, PROXY_TASK_PRIORITY,
+                          &proxyTaskHandle, PROXY_TASK_CORE);
+}
@@ -0,0 +1,46 @@
+#ifndef PROXY_H
+#define PROXY_H
+
+#include <NimBLEDevice.h>
+
+#define PROXY_MAX_CLIENTS 2          // NimBLE allows 3 links by default; one is the V1
+#define PROXY_NOTIFY_QUEUE_LEN 16    // per client; a full alert table (15) fits for batching
+#define PROXY_CMD_QUEUE_LEN 4        // per client; further writes are rejected until it drains
+#define PROXY_MAX_PACKET 64
+#define PROXY_BATCH_MAX 244          // ATT payload at the preferred MTU (BLE_PREFERRED_MTU - 3)
+#define PROXY_BATCH_HOLD_MS 10       // longest a frame waits for the rest of its alert table
+#define PROXY_RETRY_MS 5
+#define PROXY_TASK_CORE 0
+#define PROXY_TASK_PRIORITY 2
+#define PROXY_TASK_STACK 3072
+
+// Forward time is measured from the V1 notification arriving to the packet being
+// handed to the host stack for that client's link.
+struct ProxyLinkStats {
+  uint16_t connHandle;
+  bool subscribed;
+  bool batching;              // subscribed to the long characteristic with proxyBatch on
+  uint16_t mtu;
+  uint32_t forwarded;
+  uint32_t queued;            // went through the client's queue instead of straight out
+  uint32_t dropped;           // client queue full, packet too long or refused by the host
+  uint32_t lastUs;
+  uint32_t maxUs;
+  uint64_t totalUs;
+  uint32_t commands;          // writes handed to the V1 command scheduler
+  uint32_t commandsRejected;  // command queue full, or not a V1 frame
+  uint32_t batches;           // notifications on the long characteristic
+  uint32_t batchedFrames;     // V1 frames they carried
+};
+
+void proxyInit(NimBLECharacteristic *notifyChar, NimBLECharacteristic *longChar);
+bool proxyAddClient(uint16_t connHandle);
+void proxyRemoveClient(uint16_t connHandle);
+uint8_t proxyClientCount();
+void proxySetSubscriber(uint16_t connHandle, bool subscribed);
+void proxySetLongSubscriber(uint16_t connHandle, bool subscribed);
+void proxyForward(const uint8_t *data, size_t length);
+bool proxyQueueCommand(uint16_t connHandle, const uint8_t *data, size_t length);
+uint8_t getProxyStats(ProxyLinkStats *out, uint8_t max);
+
+#endif // PROXY_H
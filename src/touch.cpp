@@ -0,0 +1,138 @@
+#include "touch.h"
+#include "TouchDrvCSTXXX.hpp"
+#include <ui/ui.h>
+#include "esp_timer.h"
+
+static TaskHandle_t touchTaskHandle = NULL;
+static QueueHandle_t touchEventQueue = NULL;
+
+// last point for the LVGL indev, so its read_cb never touches I2C
+static portMUX_TYPE touchMux = portMUX_INITIALIZER_UNLOCKED;
+static int16_t touchX = 0, touchY = 0;
+static bool touchDown = false;
+
+static portMUX_TYPE touchStatsMux = portMUX_INITIALIZER_UNLOCKED;
+static TouchStats touchStats = {};
+
+bool getTouchPoint(int16_t &x, int16_t &y)
+{
+  portENTER_CRITICAL(&touchMux);
+  x = touchX;
+  y = touchY;
+  bool down = touchDown;
+  portEXIT_CRITICAL(&touchMux);
+  return down;
+}
+
+void getTouchStats(TouchStats &out)
+{
+  portENTER_CRITICAL(&touchStatsMux);
+  out = touchStats;
+  portEXIT_CRITICAL(&touchStatsMux);
+}
+
+void recordTouchMute(const TouchEvent &ev)
+{
+  uint32_t us = esp_timer_get_time() - ev.irqUs;
+  portENTER_CRITICAL(&touchStatsMux);
+  touchStats.mutes++;
+  touchStats.lastMuteUs = us;
+  if (us > touchStats.maxMuteUs) touchStats.maxMuteUs = us;
+  portEXIT_CRITICAL(&touchStatsMux);
+  Serial.printf("Touch: mute queued %u us after touch\n", us);
+}
+
+static void pushEvent(TouchEventType type, int16_t x, int16_t y, int64_t irqUs)
+{
+  TouchEvent ev = { type, x, y, irqUs };
+  bool queued = xQueueSend(touchEventQueue, &ev, 0) == pdTRUE;
+
+  portENTER_CRITICAL(&touchStatsMux);
+  if (queued) touchStats.events++;
+  else touchStats.dropped++;
+  portEXIT_CRITICAL(&touchStatsMux);
+}
+
+// One I2C read per controller interrupt. Gestures are classified here, so the UI side
+// only sees finished taps, swipes and long presses.
+static void touchTask(void *pvParameters)
+{
+  LilyGo_Display *board = static_cast<LilyGo_Display *>(pvParameters);
+  bool down = false;
+  bool longSent = false;
+  int16_t startX = 0, startY = 0, lastX = 0, lastY = 0;
+  uint32_t downMs = 0;
+
+  for (;;) {
+    bool irq = ulTaskNotifyTake(pdTRUE, down ? pdMS_TO_TICKS(TOUCH_HELD_POLL_MS) : portMAX_DELAY) > 0;
+    touchInterrupt = false;
+    int64_t eventUs = irq ? touchInterruptUs : esp_timer_get_time();
+
+    int16_t x, y;
+    bool touched = board->getPoint(&x, &y, 1) > 0;
+
+    portENTER_CRITICAL(&touchMux);
+    if (touched) {
+      touchX = x;
+      touchY = y;
+    }
+    touchDown = touched;
+    portEXIT_CRITICAL(&touchMux);
+
+    if (touched) {
+      if (!down) {
+        down = true;
+        longSent = false;
+        startX = x;
+        startY = y;
+        downMs = millis();
+      }
+      lastX = x;
+      lastY = y;
+      if (!longSent && millis() - downMs >= TOUCH_LONG_PRESS_MS) {
+        longSent = true;
+        pushEvent(TOUCH_LONG_PRESS, x, y, eventUs);
+      }
+    } else if (down) {
+      down = false;
+      if (longSent) continue;
+
+      int16_t dx = lastX - startX;
+      int16_t dy = lastY - startY;
+      if (abs(dx) >= TOUCH_SWIPE_MIN_PX && abs(dx) > abs(dy)) {
+        pushEvent(dx < 0 ? TOUCH_SWIPE_LEFT : TOUCH_SWIPE_RIGHT, lastX, lastY, eventUs);
+      } else if (abs(dx) < TOUCH_SWIPE_MIN_PX && abs(dy) < TOUCH_SWIPE_MIN_PX) {
+        pushEvent(TOUCH_TAP, lastX, lastY, eventUs);
+      }
+    }
+  }
+}
+
+// Called from the UI task each frame. Main screen gestures go to handleTouchEvent; the
+// settings screens keep using LVGL's own gesture handling through the indev.
+void dispatchTouchEvents()
+{
+  if (!touchEventQueue) return;
+
+  TouchEvent ev;
+  while (xQueueReceive(touchEventQueue, &ev, 0) == pdTRUE) {
+    uint32_t us = esp_timer_get_time() - ev.irqUs;
+    portENTER_CRITICAL(&touchStatsMux);
+    if (us > touchStats.maxDispatchUs) touchStats.maxDispatchUs = us;
+    portEXIT_CRITICAL(&touchStatsMux);
+
+    if (lv_scr_act() == objects.main) {
+      handleTouchEvent(ev);
+    }
+  }
+}
+
+void startTouchReader(LilyGo_Display &board)
+{
+  if (!board.hasTouch()) return;
+
+  touchEventQueue = xQueueCreate(TOUCH_EVENT_QUEUE_LEN, sizeof(TouchEvent));
+  xTaskCreatePinnedToCore(touchTask, "TouchTask", TOUCH_TASK_STACK, &board, TOUCH_TASK_PRIORITY,
+                          &touchTaskHandle, TOUCH_TASK_CORE);
+  touchNotifyTask = touchTaskHandle;
+}
@@ -0,0 +1,48 @@
+#ifndef TOUCH_H
+#define TOUCH_H
+
+#include <Arduino.h>
+#include "LilyGo_Display.h"
+
+#define TOUCH_TASK_CORE 1
+#define TOUCH_TASK_PRIORITY 4        // above the UI task, so a touch is read as soon as INT fires
+#define TOUCH_TASK_STACK 3072
+#define TOUCH_EVENT_QUEUE_LEN 8
+#define TOUCH_HELD_POLL_MS 30        // re-read while a finger is down in case the release edge is missed
+#define TOUCH_LONG_PRESS_MS 2000
+#define TOUCH_SWIPE_MIN_PX 50
+
+enum TouchEventType : uint8_t {
+  TOUCH_TAP = 0,
+  TOUCH_LONG_PRESS,
+  TOUCH_SWIPE_LEFT,
+  TOUCH_SWIPE_RIGHT,
+};
+
+// A classified gesture; irqUs is the esp_timer time of the interrupt that completed it.
+struct TouchEvent {
+  TouchEventType type;
+  int16_t x;
+  int16_t y;
+  int64_t irqUs;
+};
+
+struct TouchStats {
+  uint32_t events;
+  uint32_t dropped;           // ring full when the event was classified
+  uint32_t maxDispatchUs;     // interrupt -> handler
+  uint32_t mutes;
+  uint32_t lastMuteUs;        // interrupt -> mute queued for the V1 (see v1Commands.mute)
+  uint32_t maxMuteUs;
+};
+
+void startTouchReader(LilyGo_Display &board);
+bool getTouchPoint(int16_t &x, int16_t &y);
+void dispatchTouchEvents();
+void recordTouchMute(const TouchEvent &ev);
+void getTouchStats(TouchStats &out);
+
+// implemented in utils.cpp, next to the BLE write paths it drives
+void handleTouchEvent(const TouchEvent &ev);
+
+#endif // TOUCH_H
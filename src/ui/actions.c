@@ -3,6 +3,8 @@
 #include "images.h"
 #include "../utils.h"
 #include "blinking.h"
+#include "glyph_atlas.h"
+#include "styles.h"
 #include "screens.h"
 #include "ui.h"
 #include "esp_heap_caps.h"
@@ -240,23 +242,8 @@ void show_popup(const char * message) {
 }
 
 void update_alert_display(bool muted) {
-
-    lv_color_t text_color = muted ? lv_color_hex(gray_color) : lv_color_hex(default_color);
-    const void* front_arrow_src = muted ? &img_arrow_front_gray_4bit : &img_arrow_front;
-    const void* side_arrow_src = muted ? &img_arrow_side_gray_4bit : &img_arrow_side;
-    const void* rear_arrow_src = muted ? &img_arrow_rear_gray_4bit : &img_arrow_rear;
-
-    lv_obj_set_style_text_color(objects.prioalertfreq, text_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(objects.band_k, text_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(objects.band_ka, text_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(objects.band_x, text_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(objects.default_mode, text_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(objects.bogey_count, text_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(objects.custom_freq_en, text_color, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_img_set_src(objects.front_arrow, front_arrow_src);
-    lv_img_set_src(objects.side_arrow, side_arrow_src);
-    lv_img_set_src(objects.rear_arrow, rear_arrow_src);
-    
+    // labels, alert rows and arrows all take their colour from the alert_color style
+    set_style_alert_color(lv_color_hex(muted ? gray_color : default_color));
 }
 
 lv_img_dsc_t *allocate_image_in_psram(const lv_img_dsc_t *src_img) {
@@ -300,7 +287,7 @@ uint32_t get_bar_color(int i) {
 
 void enter_laser_mode() {
     lv_obj_set_style_text_color(objects.prioalertfreq, lv_color_hex(0xffffffff), 0);
-    lv_label_set_text(objects.prioalertfreq, "LASER");
+    atlas_label_set_text(objects.prioalertfreq, "LASER");
     lv_obj_set_style_bg_color(objects.main, lv_color_hex(0xffff0000), LV_PART_MAIN | LV_STATE_DEFAULT);
 
     lv_obj_t * objs_to_hide[] = {
@@ -318,7 +305,7 @@ void enter_laser_mode() {
 
 void exit_laser_mode() {
     lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0xff000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(objects.prioalertfreq, lv_color_hex(0xffff0000), 0);
+    lv_obj_remove_local_style_prop(objects.prioalertfreq, LV_STYLE_TEXT_COLOR, LV_PART_MAIN | LV_STATE_DEFAULT);
 }
 
 static void hide_after_animation_cb(lv_anim_t * a) {
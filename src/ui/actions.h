@@ -10,7 +10,6 @@ extern "C" {
 #define MAX_BARS 6
 #define MAX_ALERT_ROWS 4
 
-void main_press_handler(lv_event_t * e);
 void v1cle_switch_event_handler(lv_event_t * e);
 void proxy_switch_event_handler(lv_event_t * e);
 void wifi_switch_event_handler(lv_event_t * e);
@@ -8,8 +8,13 @@ bool blink_enabled[MAX_BLINK_IMAGES] = {false}; // Track which element should bl
 uint8_t blink_count = 0;
 uint8_t cur_bars = 0;
 
-static lv_timer_t *blink_toggle_timers[MAX_BLINK_IMAGES] = {NULL};
-static lv_timer_t *blink_timeout_timers[MAX_BLINK_IMAGES] = {NULL};
+static lv_timer_t *blink_timer = NULL;
+static uint8_t blink_active_mask = 0;      // bit per BlinkIndices entry
+static uint8_t blink_hide_mask = 0;        // disabled since the last tick, hide on the next one
+static uint32_t blink_expiry[MAX_BLINK_IMAGES];
+static bool blink_phase_visible = true;
+static uint32_t clear_bands_at = 0;
+static bool clear_bands_pending = false;
 
 static void band_update_timer(lv_timer_t * timer) {
     if (activeBands & 0b00000001) { // Laser
@@ -30,82 +35,97 @@ void start_band_update_timer() {
     lv_timer_create(band_update_timer, 500, NULL); // Check every 500ms
 }
 
-static void clear_inactive_bands_timer(lv_timer_t * timer) {
-    activeBands = 0;
-    lv_timer_del(timer);
-}
-
 void start_clear_inactive_bands_timer() {
-    lv_timer_create(clear_inactive_bands_timer, INACTIVE_BAND_TIMEOUT, NULL);
+    // called from the BLE task: only arm the deadline, blink_tick_cb clears the bands
+    if (!__atomic_load_n(&clear_bands_pending, __ATOMIC_ACQUIRE)) {
+        clear_bands_at = lv_tick_get() + INACTIVE_BAND_TIMEOUT;
+        __atomic_store_n(&clear_bands_pending, true, __ATOMIC_RELEASE);
+    }
 }
 
-static void blink_timeout_cb(lv_timer_t *timer) {
-    int index = (int)timer->user_data;
-    blink_enabled[index] = false;
-    blink_timeout_timers[index] = NULL;
-    lv_timer_del(timer);
-}
+// Every blinking element follows one phase driven by a single timer, so arrows and
+// bands flash together like on the V1 and a phase change is one invalidation pass.
+// enable/disable only touch the masks and expiry times and may be called from the BLE
+// task; all object changes happen in blink_tick_cb on the LVGL side.
+static void blink_tick_cb(lv_timer_t *timer) {
+    uint32_t now = lv_tick_get();
 
-static void blink_toggle_cb(lv_timer_t *timer) {
-    int index = (int)timer->user_data;
+    if (__atomic_load_n(&clear_bands_pending, __ATOMIC_ACQUIRE) && (int32_t)(now - clear_bands_at) >= 0) {
+        activeBands = 0;
+        __atomic_store_n(&clear_bands_pending, false, __ATOMIC_RELEASE);
+    }
+
+    uint8_t hide = __atomic_exchange_n(&blink_hide_mask, 0, __ATOMIC_ACQ_REL);
+    for (int i = 0; i < MAX_BLINK_IMAGES; i++) {
+        if ((hide & (1 << i)) && blink_images[i]) lv_obj_add_flag(blink_images[i], LV_OBJ_FLAG_HIDDEN);
+    }
 
-    if (!blink_enabled[index]) {
-        blink_toggle_timers[index] = NULL;
-        lv_timer_del(timer);
+    uint8_t active = __atomic_load_n(&blink_active_mask, __ATOMIC_ACQUIRE);
+    if (!active) {
+        blink_phase_visible = true;
         return;
     }
 
-    lv_obj_t *obj = blink_images[index];
-    if (obj) {
-        bool is_hidden = lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN);
-        if (is_hidden) {
-            lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    blink_phase_visible = !blink_phase_visible;
+    for (int i = 0; i < MAX_BLINK_IMAGES; i++) {
+        if (!(active & (1 << i))) continue;
+
+        if ((int32_t)(now - blink_expiry[i]) >= 0) {
+            // finished: leave it to the regular screen tick to show or hide
+            __atomic_fetch_and(&blink_active_mask, (uint8_t)~(1 << i), __ATOMIC_ACQ_REL);
+            blink_enabled[i] = false;
+            continue;
+        }
+
+        lv_obj_t *obj = blink_images[i];
+        if (obj && lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == blink_phase_visible) {
+            blink_phase_visible ? lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN)
+                                : lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
         }
     }
 }
 
 void disable_blinking(int index) {
-    if (index < 0 || index >= MAX_BLINK_IMAGES) { 
-        return; 
-    }
-    lv_obj_t * obj = blink_images[index];
-    
-    if (obj == NULL) {
+    if (index < 0 || index >= MAX_BLINK_IMAGES || blink_images[index] == NULL) {
         return;
     }
 
-    blink_enabled[index] = false;  // The timer will check this and stop itself
-    lv_obj_add_flag(blink_images[index], LV_OBJ_FLAG_HIDDEN);
+    blink_enabled[index] = false;
+    __atomic_fetch_and(&blink_active_mask, (uint8_t)~(1 << index), __ATOMIC_ACQ_REL);
+    __atomic_fetch_or(&blink_hide_mask, (uint8_t)(1 << index), __ATOMIC_ACQ_REL);
 }
 
 void enable_blinking(int index) {
-    if (blink_toggle_timers[index] != NULL) {
+    if (index < 0 || index >= MAX_BLINK_IMAGES) {
         return;
     }
 
+    // re-enabling an element that is already blinking extends it in the same phase
+    blink_expiry[index] = lv_tick_get() + BLINK_DURATION_MS;
     blink_enabled[index] = true;
-    LV_LOG_INFO("enable blinking at index %d", index);
-
-    blink_toggle_timers[index] = lv_timer_create(blink_toggle_cb, BLINK_FREQUENCY, (void*)index);
-    blink_timeout_timers[index] = lv_timer_create(blink_timeout_cb, BLINK_DURATION_MS, (void*)index);
+    __atomic_fetch_and(&blink_hide_mask, (uint8_t)~(1 << index), __ATOMIC_ACQ_REL);
+    if (!(__atomic_fetch_or(&blink_active_mask, (uint8_t)(1 << index), __ATOMIC_ACQ_REL) & (1 << index))) {
+        LV_LOG_INFO("enable blinking at index %d", index);
+    }
 }
 
 void register_blinking_image(int index, lv_obj_t *obj) {
     if (index < 0 || index >= MAX_BLINK_IMAGES) return;
     blink_images[index] = obj;
+    if (index >= blink_count) blink_count = index + 1;
 }
 
-static void blink_timer_cb(lv_timer_t *timer) {
-    for (int i = 0; i < blink_count; i++) {
-        if (blink_enabled[i]) {
-            bool is_hidden = lv_obj_has_flag(blink_images[i], LV_OBJ_FLAG_HIDDEN);
-            lv_obj_add_flag(blink_images[i], is_hidden ? LV_OBJ_FLAG_HIDDEN : 0);
-        } 
-    }
+bool is_blinking(int index) {
+    if (index < 0 || index >= MAX_BLINK_IMAGES) return false;
+    return (__atomic_load_n(&blink_active_mask, __ATOMIC_ACQUIRE) & (1 << index)) != 0;
+}
+
+bool is_blinking_active(void) {
+    return __atomic_load_n(&blink_active_mask, __ATOMIC_ACQUIRE) != 0;
 }
 
 void init_blinking_system() {
-    lv_timer_create(blink_timer_cb, BLINK_FREQUENCY, NULL);
-}
\ No newline at end of file
+    if (blink_timer == NULL) {
+        blink_timer = lv_timer_create(blink_tick_cb, BLINK_FREQUENCY, NULL);
+    }
+}
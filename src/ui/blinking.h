@@ -24,15 +24,15 @@ extern lv_obj_t *blink_images[MAX_BLINK_IMAGES];
 extern bool blink_enabled[MAX_BLINK_IMAGES];
 extern uint8_t blink_count;
 
-static void blink_timeout_cb(lv_timer_t *timer);
 extern void enable_blinking(int index);
 extern void disable_blinking(int index);
 
-static void clear_inactive_bands_timer(lv_timer_t * timer);
 void start_clear_inactive_bands_timer();
 void start_band_update_timer();
 
 void register_blinking_image(int index, lv_obj_t *obj);
+bool is_blinking(int index);
+bool is_blinking_active(void);
 void init_blinking_system(void);
 
 #ifdef __cplusplus
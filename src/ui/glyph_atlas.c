@@ -0,0 +1,216 @@
+#include <string.h>
+#include "glyph_atlas.h"
+#include "esp_heap_caps.h"
+
+typedef struct {
+    const lv_font_t *font;
+    char text[ATLAS_LABEL_MAX_LEN + 1];
+} atlas_label_t;
+
+static glyph_atlas_t atlases[GLYPH_ATLAS_MAX];
+static uint8_t atlas_count = 0;
+
+static lv_img_dsc_t *build_tile(const lv_font_t *font, uint32_t letter, lv_color_t color) {
+    lv_font_glyph_dsc_t g;
+    if (!lv_font_get_glyph_dsc(font, &g, letter, 0) || g.adv_w == 0) return NULL;
+
+    const uint16_t w = g.adv_w;
+    const uint16_t h = font->line_height;
+    const uint32_t size = (uint32_t)w * h * sizeof(lv_color_t);
+
+    lv_img_dsc_t *tile = (lv_img_dsc_t *)malloc(sizeof(lv_img_dsc_t));
+    lv_color_t *px = (lv_color_t *)heap_caps_aligned_alloc(32, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!tile || !px) {
+        LV_LOG_ERROR("Glyph atlas: out of PSRAM for U+%04X", (unsigned)letter);
+        free(tile);
+        free(px);
+        return NULL;
+    }
+
+    const lv_color_t bg = lv_color_black();
+    for (uint32_t i = 0; i < (uint32_t)w * h; i++) px[i] = bg;
+
+    // same placement as lv_draw_letter: glyph rows are bit-packed without row padding
+    const uint8_t *bmp = lv_font_get_glyph_bitmap(font, letter);
+    const uint8_t bpp = g.bpp;
+    const uint8_t max_val = (1 << bpp) - 1;
+    const int y0 = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+    if (bmp) {
+        for (int r = 0; r < g.box_h; r++) {
+            int ty = y0 + r;
+            if (ty < 0 || ty >= h) continue;
+            for (int c = 0; c < g.box_w; c++) {
+                int tx = g.ofs_x + c;
+                if (tx < 0 || tx >= w) continue;
+                uint32_t bit = ((uint32_t)r * g.box_w + c) * bpp;
+                uint8_t v = (bmp[bit >> 3] >> (8 - bpp - (bit & 7))) & max_val;
+                if (v) px[ty * w + tx] = lv_color_mix(color, bg, (lv_opa_t)(v * 255 / max_val));
+            }
+        }
+    }
+
+    tile->header.always_zero = 0;
+    tile->header.reserved = 0;
+    tile->header.cf = LV_IMG_CF_TRUE_COLOR;
+    tile->header.w = w;
+    tile->header.h = h;
+    tile->data_size = size;
+    tile->data = (const uint8_t *)px;
+    return tile;
+}
+
+const glyph_atlas_t *glyph_atlas_find(const lv_font_t *font, lv_color_t color) {
+    for (uint8_t i = 0; i < atlas_count; i++) {
+        if (atlases[i].font == font && atlases[i].color.full == color.full) return &atlases[i];
+    }
+    return NULL;
+}
+
+bool glyph_atlas_build(const lv_font_t *font, lv_color_t color) {
+    if (glyph_atlas_find(font, color)) return true;
+    if (atlas_count >= GLYPH_ATLAS_MAX) {
+        LV_LOG_WARN("Glyph atlas: table full");
+        return false;
+    }
+
+    glyph_atlas_t *atlas = &atlases[atlas_count];
+    memset(atlas, 0, sizeof(*atlas));
+    atlas->font = font;
+    atlas->color = color;
+
+    uint32_t bytes = 0;
+    uint8_t glyphs = 0;
+    for (uint32_t c = GLYPH_ATLAS_FIRST_CHAR; c <= GLYPH_ATLAS_LAST_CHAR; c++) {
+        lv_img_dsc_t *tile = build_tile(font, c, color);
+        atlas->tiles[c - GLYPH_ATLAS_FIRST_CHAR] = tile;
+        if (tile) {
+            bytes += tile->data_size;
+            glyphs++;
+        }
+    }
+    atlas_count++;
+
+    LV_LOG_USER("Glyph atlas: %u glyphs, %u bytes in PSRAM", glyphs, (unsigned)bytes);
+    return glyphs > 0;
+}
+
+static inline const lv_img_dsc_t *atlas_tile(const glyph_atlas_t *atlas, char c) {
+    if ((uint8_t)c < GLYPH_ATLAS_FIRST_CHAR || (uint8_t)c > GLYPH_ATLAS_LAST_CHAR) return NULL;
+    return atlas->tiles[(uint8_t)c - GLYPH_ATLAS_FIRST_CHAR];
+}
+
+static lv_coord_t glyph_advance(const lv_font_t *font, char c) {
+    lv_font_glyph_dsc_t g;
+    return lv_font_get_glyph_dsc(font, &g, (uint8_t)c, 0) ? g.adv_w : 0;
+}
+
+static void atlas_label_event_cb(lv_event_t *e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    atlas_label_t *lbl = (atlas_label_t *)lv_obj_get_user_data(obj);
+
+    if (code == LV_EVENT_DELETE) {
+        lv_mem_free(lbl);
+        lv_obj_set_user_data(obj, NULL);
+    }
+    else if (code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t *p = (lv_point_t *)lv_event_get_param(e);
+        lv_coord_t w = 0;
+        for (const char *c = lbl->text; *c; c++) w += glyph_advance(lbl->font, *c);
+        p->x = LV_MAX(p->x, w);
+        p->y = LV_MAX(p->y, lv_font_get_line_height(lbl->font));
+    }
+    else if (code == LV_EVENT_DRAW_MAIN) {
+        if (lbl->text[0] == '\0') return;
+
+        lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+        lv_area_t coords;
+        lv_obj_get_content_coords(obj, &coords);
+
+        const glyph_atlas_t *atlas = glyph_atlas_find(lbl->font, lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+        if (!atlas) {
+            lv_draw_label_dsc_t label_dsc;
+            lv_draw_label_dsc_init(&label_dsc);
+            lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+            lv_draw_label(draw_ctx, &label_dsc, &coords, lbl->text, NULL);
+            return;
+        }
+
+        // opaque RGB565 tiles at zoom 256 go straight to the blend's line copy
+        lv_draw_img_dsc_t img_dsc;
+        lv_draw_img_dsc_init(&img_dsc);
+
+        lv_area_t cell;
+        cell.x1 = coords.x1;
+        cell.y1 = coords.y1;
+        cell.y2 = coords.y1 + lv_font_get_line_height(lbl->font) - 1;
+        for (const char *c = lbl->text; *c; c++) {
+            const lv_img_dsc_t *tile = atlas_tile(atlas, *c);
+            if (!tile) continue;
+            cell.x2 = cell.x1 + tile->header.w - 1;
+            if (_lv_area_is_on(&cell, draw_ctx->clip_area)) {
+                lv_draw_img_decoded(draw_ctx, &img_dsc, &cell, tile->data, LV_IMG_CF_TRUE_COLOR);
+            }
+            cell.x1 = cell.x2 + 1;
+        }
+    }
+}
+
+lv_obj_t *atlas_label_create(lv_obj_t *parent, const lv_font_t *font) {
+    atlas_label_t *lbl = (atlas_label_t *)lv_mem_alloc(sizeof(atlas_label_t));
+    LV_ASSERT_MALLOC(lbl);
+    lbl->font = font;
+    lbl->text[0] = '\0';
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_user_data(obj, lbl);
+    lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_style_text_font(obj, font, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_GESTURE_BUBBLE);
+    lv_obj_add_event_cb(obj, atlas_label_event_cb, LV_EVENT_ALL, NULL);
+    return obj;
+}
+
+void atlas_label_set_text(lv_obj_t *obj, const char *text) {
+    atlas_label_t *lbl = (atlas_label_t *)lv_obj_get_user_data(obj);
+    if (!lbl || !text) return;
+
+    char next[ATLAS_LABEL_MAX_LEN + 1];
+    strncpy(next, text, ATLAS_LABEL_MAX_LEN);
+    next[ATLAS_LABEL_MAX_LEN] = '\0';
+
+    size_t len = strlen(next);
+    if (len != strlen(lbl->text)) {
+        strcpy(lbl->text, next);
+        lv_obj_invalidate(obj);
+        lv_obj_refresh_self_size(obj);
+        return;
+    }
+
+    // same length: only redraw the cells whose character changed
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+    lv_area_t cell = coords;
+    bool resized = false;
+    for (size_t i = 0; i < len; i++) {
+        lv_coord_t old_w = glyph_advance(lbl->font, lbl->text[i]);
+        lv_coord_t new_w = glyph_advance(lbl->font, next[i]);
+        if (old_w != new_w) resized = true;
+        cell.x2 = cell.x1 + LV_MAX(old_w, new_w) - 1;
+        if (lbl->text[i] != next[i] && !resized) lv_obj_invalidate_area(obj, &cell);
+        cell.x1 += old_w;
+    }
+    strcpy(lbl->text, next);
+
+    if (resized) {
+        lv_obj_invalidate(obj);
+        lv_obj_refresh_self_size(obj);
+    }
+}
+
+const char *atlas_label_get_text(lv_obj_t *obj) {
+    atlas_label_t *lbl = (atlas_label_t *)lv_obj_get_user_data(obj);
+    return lbl ? lbl->text : "";
+}
@@ -0,0 +1,37 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GLYPH_ATLAS_MAX 4           // font/color pairs kept in PSRAM
+#define GLYPH_ATLAS_FIRST_CHAR 0x20
+#define GLYPH_ATLAS_LAST_CHAR 0x7E
+#define ATLAS_LABEL_MAX_LEN 15
+
+// Pre-rendered RGB565 tiles for every glyph a font provides, one tile per character
+// cell (advance width x line height), blended once against the black screen background.
+typedef struct {
+    const lv_font_t *font;
+    lv_color_t color;
+    lv_img_dsc_t *tiles[GLYPH_ATLAS_LAST_CHAR - GLYPH_ATLAS_FIRST_CHAR + 1];
+} glyph_atlas_t;
+
+bool glyph_atlas_build(const lv_font_t *font, lv_color_t color);
+const glyph_atlas_t *glyph_atlas_find(const lv_font_t *font, lv_color_t color);
+
+// A label that blits atlas tiles instead of rasterizing glyphs. It takes its colour
+// from the text_color style like a normal label and falls back to lv_draw_label when
+// no atlas exists for that colour.
+lv_obj_t *atlas_label_create(lv_obj_t *parent, const lv_font_t *font);
+void atlas_label_set_text(lv_obj_t *obj, const char *text);
+const char *atlas_label_get_text(lv_obj_t *obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,18 +1,12 @@
 #include "images.h"
 
-const ext_img_desc_t images[19] = {
+const ext_img_desc_t images[13] = {
     { "v1gen2logo-white", &img_v1gen2logo_white },
     { "bt_logo_small", &img_bt_logo_small },
     { "bt_proxy", &img_bt_proxy },
     { "location_disabled", &img_location_disabled },
     { "mute_logo_small", &img_mute_logo_small },
     { "location_red", &img_location_red },
-    { "arrow_front_gray_4bit", &img_arrow_front_gray_4bit },
-    { "arrow_front", &img_arrow_front },
-    { "arrow_side", &img_arrow_side },
-    { "arrow_side_gray", &img_arrow_side_gray_4bit },
-    { "arrow_rear", &img_arrow_rear },
-    { "arrow_rear_gray", &img_arrow_rear_gray_4bit },
     { "small_arrow_rear", &img_small_arrow_rear },
     { "small_arrow_front", &img_small_arrow_front },
     { "small_arrow_side", &img_small_arrow_side },
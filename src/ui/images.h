@@ -2,6 +2,7 @@
 #define EEZ_LVGL_UI_IMAGES_H
 
 #include "lvgl.h"
+#include "rle_img.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -13,12 +14,6 @@ extern const lv_img_dsc_t img_bt_proxy;
 extern const lv_img_dsc_t img_location_disabled;
 extern const lv_img_dsc_t img_mute_logo_small;
 extern const lv_img_dsc_t img_location_red;
-extern const lv_img_dsc_t img_arrow_front;
-extern const lv_img_dsc_t img_arrow_front_gray_4bit;
-extern const lv_img_dsc_t img_arrow_side;
-extern const lv_img_dsc_t img_arrow_side_gray_4bit;
-extern const lv_img_dsc_t img_arrow_rear;
-extern const lv_img_dsc_t img_arrow_rear_gray_4bit;
 extern const lv_img_dsc_t img_small_arrow_rear;
 extern const lv_img_dsc_t img_small_arrow_front;
 extern const lv_img_dsc_t img_small_arrow_side;
@@ -36,7 +31,12 @@ typedef struct _ext_img_desc_t {
 } ext_img_desc_t;
 #endif
 
-extern const ext_img_desc_t images[19];
+extern const ext_img_desc_t images[13];
+
+// run-length encoded, decoded into PSRAM on first use with rle_img_get()
+extern const rle_img_t img_arrow_front;
+extern const rle_img_t img_arrow_side;
+extern const rle_img_t img_arrow_rear;
 
 
 #ifdef __cplusplus
@@ -0,0 +1,93 @@
+#include <string.h>
+#include "rle_img.h"
+#include "esp_heap_caps.h"
+
+typedef struct {
+    const rle_img_t *src;
+    uint32_t palette[RLE_IMG_MAX_COLORS];
+    lv_img_dsc_t dsc;
+} rle_cache_entry_t;
+
+static rle_cache_entry_t cache[RLE_IMG_CACHE_SIZE];
+static uint8_t cache_count = 0;
+
+static bool decode(const rle_img_t *img, const uint32_t *palette, lv_img_dsc_t *out) {
+    bool opaque = true;
+    lv_color_t colors[RLE_IMG_MAX_COLORS];
+    lv_opa_t alphas[RLE_IMG_MAX_COLORS];
+    for (uint8_t i = 0; i < img->palette_size; i++) {
+        colors[i] = lv_color_hex(palette[i] & 0xFFFFFF);
+        alphas[i] = palette[i] >> 24;
+        if (alphas[i] != LV_OPA_COVER) opaque = false;
+    }
+
+    const uint8_t px_size = opaque ? sizeof(lv_color_t) : LV_IMG_PX_SIZE_ALPHA_BYTE;
+    const uint32_t pixels = (uint32_t)img->w * img->h;
+    uint8_t *data = (uint8_t *)heap_caps_aligned_alloc(32, pixels * px_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!data) {
+        LV_LOG_ERROR("RLE image: out of PSRAM (%u bytes)", (unsigned)(pixels * px_size));
+        return false;
+    }
+
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i + 1 < img->runs_size && pos < pixels; i += 2) {
+        const uint8_t idx = img->runs[i] >> 4;
+        uint32_t len = (((uint32_t)(img->runs[i] & 0x0F) << 8) | img->runs[i + 1]) + 1;
+        if (idx >= img->palette_size) {
+            LV_LOG_ERROR("RLE image: bad palette index %u", idx);
+            heap_caps_free(data);
+            return false;
+        }
+        if (len > pixels - pos) len = pixels - pos;
+
+        if (opaque) {
+            lv_color_t *p = (lv_color_t *)data + pos;
+            for (uint32_t n = 0; n < len; n++) p[n] = colors[idx];
+        } else {
+            uint8_t *p = data + pos * LV_IMG_PX_SIZE_ALPHA_BYTE;
+            for (uint32_t n = 0; n < len; n++, p += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+                memcpy(p, &colors[idx], sizeof(lv_color_t));
+                p[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = alphas[idx];
+            }
+        }
+        pos += len;
+    }
+    if (pos < pixels) {
+        LV_LOG_WARN("RLE image: runs cover %u of %u pixels", (unsigned)pos, (unsigned)pixels);
+        memset(data + pos * px_size, 0, (pixels - pos) * px_size);
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->header.cf = opaque ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_TRUE_COLOR_ALPHA;
+    out->header.w = img->w;
+    out->header.h = img->h;
+    out->data_size = pixels * px_size;
+    out->data = data;
+    return true;
+}
+
+const lv_img_dsc_t *rle_img_get(const rle_img_t *img, const uint32_t *palette) {
+    if (!img) return NULL;
+    if (!palette) palette = img->palette;
+
+    const size_t palette_bytes = img->palette_size * sizeof(uint32_t);
+    for (uint8_t i = 0; i < cache_count; i++) {
+        if (cache[i].src == img && memcmp(cache[i].palette, palette, palette_bytes) == 0) {
+            return &cache[i].dsc;
+        }
+    }
+
+    if (cache_count >= RLE_IMG_CACHE_SIZE) {
+        LV_LOG_ERROR("RLE image: decode cache full");
+        return NULL;
+    }
+
+    rle_cache_entry_t *entry = &cache[cache_count];
+    if (!decode(img, palette, &entry->dsc)) return NULL;
+    entry->src = img;
+    memcpy(entry->palette, palette, palette_bytes);
+    cache_count++;
+
+    LV_LOG_INFO("RLE image: decoded %ux%u from %u bytes", img->w, img->h, (unsigned)img->runs_size);
+    return &entry->dsc;
+}
@@ -0,0 +1,33 @@
+#ifndef RLE_IMG_H
+#define RLE_IMG_H
+
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RLE_IMG_MAX_COLORS 16
+#define RLE_IMG_CACHE_SIZE 8
+
+// Palette image stored run-length encoded in flash (see img_rle_converter.py).
+// Palette entries are 0xAARRGGBB.
+typedef struct {
+    uint16_t w;
+    uint16_t h;
+    uint8_t palette_size;
+    const uint32_t *palette;
+    uint32_t runs_size;
+    const uint8_t *runs;
+} rle_img_t;
+
+// Returns a decoded image in PSRAM, decoding on first use only. palette replaces the
+// image's own palette entry for entry (NULL = built-in), so one bitmap serves every
+// colour variant. Opaque palettes decode to TRUE_COLOR, others to TRUE_COLOR_ALPHA.
+const lv_img_dsc_t *rle_img_get(const rle_img_t *img, const uint32_t *palette);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -10,6 +10,8 @@
 #include "ui.h"
 #include "../utils.h"
 #include "blinking.h"
+#include "glyph_atlas.h"
+#include "seg7.h"
 
 objects_t objects;
 lv_obj_t *tick_value_change_obj;
@@ -28,13 +30,15 @@ uint32_t green_bar = 0xff8cd47e;
 uint32_t yellow_bar = 0xfff8d66d;
 uint32_t orange_bar = 0xffffb54c;
 
+// the big arrows are decoded as white masks and coloured through the alert_color style
+static const uint32_t arrow_mask_palette[] = { 0x00000000, 0xffffffff };
+
 lv_obj_t* create_alert_row(lv_obj_t* parent, int x, int y, const char* frequency) {
-    lv_obj_t* obj = lv_label_create(parent);
+    // drawn as vector segments at the glyph height of ui_font_alarmclock_36
+    lv_obj_t* obj = seg7_create(parent, 25);
     lv_obj_set_pos(obj, x, y);
-    lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-    lv_label_set_text(obj, frequency);
-    lv_obj_set_style_text_font(obj, &ui_font_alarmclock_36, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(obj, lv_color_hex(0xffff0000), LV_PART_MAIN | LV_STATE_DEFAULT);
+    seg7_set_text(obj, frequency);
+    add_style_alert_color(obj);
     lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
     return obj;
 }
@@ -43,74 +47,111 @@ lv_obj_t* create_alert_direction(lv_obj_t* parent, int x, int y) {
     lv_obj_t* img = lv_img_create(parent);
     lv_obj_set_pos(img, x, y);
     lv_img_set_src(img, &img_small_arrow_rear); // placeholder
+    add_style_alert_color(img);
     lv_obj_set_size(img, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
     //lv_obj_set_size(img, 32, 32);
     lv_obj_add_flag(img, LV_OBJ_FLAG_HIDDEN);
     return img;
 }
 
-void create_alert_rows(lv_obj_t* parent, int num_rows) {
-    int base_x_text = 45;       // Base X position for text
-    int base_y_text = 2;      // Starting Y position
-    int y_step_text = -52;       // Vertical spacing between rows
+#define ALERT_ROW_X_TEXT 45
+#define ALERT_ROW_X_IMG -4
+#define ALERT_ROW_Y_TEXT(slot) (2 + (slot) * 52)
+#define ALERT_ROW_Y_IMG(slot) (6 + (slot) * 48)
 
-    int base_x_img = -4;
-    int base_y_img = 6;
-    int y_step_img = -48;
+// physical row (text + arrow pair) shown in each slot, and what each physical row holds
+static int8_t slot_row[MAX_ALERT_ROWS];
+static uint32_t row_hash[MAX_ALERT_ROWS];
 
+void create_alert_rows(lv_obj_t* parent, int num_rows) {
     for (int i = 0; i < num_rows && i < MAX_ALERT_ROWS; ++i) {
-        alert_rows[i] = create_alert_row(parent, base_x_text, base_y_text - (i * y_step_text), "      ");
-        alert_directions[i] = create_alert_direction(parent, base_x_img, base_y_img - (i * y_step_img));
+        alert_rows[i] = create_alert_row(parent, ALERT_ROW_X_TEXT, ALERT_ROW_Y_TEXT(i), "      ");
+        alert_directions[i] = create_alert_direction(parent, ALERT_ROW_X_IMG, ALERT_ROW_Y_IMG(i));
+        slot_row[i] = i;
+        row_hash[i] = 0;
     }
 }
 
-void update_alert_rows(int num_alerts, const char* frequencies[], bool muted, bool muteToGray) {
-    if (frequencies == NULL) {
-        return;
+static const void *alert_arrow_src(uint8_t dir) {
+    switch (dir) {
+        case 2: return &img_small_arrow_side;   // DIR_SIDE
+        case 3: return &img_small_arrow_rear;   // DIR_REAR
+        default: return &img_small_arrow_front;
     }
+}
 
-    for (int i = 0; i < MAX_ALERT_ROWS; i++) {
-        if (i < num_alerts) {
-            if (muted && muteToGray) {
-                lv_obj_set_style_text_color(alert_rows[i], lv_color_hex(gray_color), LV_PART_MAIN | LV_STATE_DEFAULT);
-            } 
-            else {
-                lv_obj_set_style_text_color(alert_rows[i], lv_color_hex(default_color), LV_PART_MAIN | LV_STATE_DEFAULT);
+// Rows that are still present keep their objects and are only moved to their new slot;
+// new rows take over a free object and only what differs is redrawn. Colour is left to
+// the alert_color style, so mute changes never come through here.
+static void update_alert_table(const alert_row_t *rows, uint8_t count) {
+    int8_t assign[MAX_ALERT_ROWS];
+    bool used[MAX_ALERT_ROWS] = { false };
+
+    if (count > MAX_ALERT_ROWS) count = MAX_ALERT_ROWS;
+
+    // keep rows whose content is unchanged
+    for (int s = 0; s < count; s++) {
+        assign[s] = -1;
+        for (int r = 0; r < MAX_ALERT_ROWS; r++) {
+            if (!used[r] && row_hash[r] == rows[s].hash) {
+                assign[s] = r;
+                used[r] = true;
+                break;
             }
-            lv_label_set_text(alert_rows[i], frequencies[i]);
-            lv_obj_clear_flag(alert_rows[i], LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_add_flag(alert_rows[i], LV_OBJ_FLAG_HIDDEN);
         }
     }
-}
-
-void update_alert_arrows(int num_alerts, const char* directions[], bool muted, bool muteToGray) {
-    if (directions == NULL) {
-        return;
-    }
 
-    for (int i = 0; i < MAX_ALERT_ROWS; i++) {
-        if (i < num_alerts && directions[i] != NULL) {
-            if (strcmp(directions[i], "FRONT") == 0) {
-                lv_img_set_src(alert_directions[i], &img_small_arrow_front);
-            } else if (strcmp(directions[i], "SIDE") == 0) {
-                lv_img_set_src(alert_directions[i], &img_small_arrow_side);
-            } else if (strcmp(directions[i], "REAR") == 0) {
-                lv_img_set_src(alert_directions[i], &img_small_arrow_rear);
-            } else {
-                lv_img_set_src(alert_directions[i], &img_small_arrow_front);
-            }
+    // hand the rest a free row, preferring the one already sitting in that slot
+    for (int s = 0; s < count; s++) {
+        if (assign[s] >= 0) continue;
+        int r = slot_row[s];
+        if (used[r]) {
+            for (r = 0; r < MAX_ALERT_ROWS && used[r]; r++);
+        }
+        assign[s] = r;
+        used[r] = true;
 
-            if (alert_directions[i] != NULL) {
-                lv_obj_clear_flag(alert_directions[i], LV_OBJ_FLAG_HIDDEN);
-            }
+        char text[8];
+        if (rows[s].freq_mhz == 0) {
+            strcpy(text, "LASER");
         } else {
-            if (alert_directions[i] != NULL) {
-                lv_obj_add_flag(alert_directions[i], LV_OBJ_FLAG_HIDDEN);
-            }
+            formatFreqMhz(rows[s].freq_mhz, text);
+        }
+        seg7_set_text(alert_rows[r], text);
+        const void *src = alert_arrow_src(rows[s].dir);
+        if (lv_img_get_src(alert_directions[r]) != src) {
+            lv_img_set_src(alert_directions[r], src);
+        }
+        row_hash[r] = rows[s].hash;
+    }
+
+    // place visible rows, then park the unused ones in the remaining slots
+    int s = 0;
+    for (; s < count; s++) {
+        int r = assign[s];
+        if (slot_row[s] != r) {
+            lv_obj_set_y(alert_rows[r], ALERT_ROW_Y_TEXT(s));
+            lv_obj_set_y(alert_directions[r], ALERT_ROW_Y_IMG(s));
+            slot_row[s] = r;
+        }
+        if (lv_obj_has_flag(alert_rows[r], LV_OBJ_FLAG_HIDDEN)) {
+            lv_obj_clear_flag(alert_rows[r], LV_OBJ_FLAG_HIDDEN);
+            lv_obj_clear_flag(alert_directions[r], LV_OBJ_FLAG_HIDDEN);
         }
     }
+    for (int r = 0; r < MAX_ALERT_ROWS; r++) {
+        if (used[r]) continue;
+        if (!lv_obj_has_flag(alert_rows[r], LV_OBJ_FLAG_HIDDEN)) {
+            lv_obj_add_flag(alert_rows[r], LV_OBJ_FLAG_HIDDEN);
+            lv_obj_add_flag(alert_directions[r], LV_OBJ_FLAG_HIDDEN);
+        }
+        if (slot_row[s] != r) {
+            lv_obj_set_y(alert_rows[r], ALERT_ROW_Y_TEXT(s));
+            lv_obj_set_y(alert_directions[r], ALERT_ROW_Y_IMG(s));
+            slot_row[s] = r;
+        }
+        s++;
+    }
 }
 
 lv_obj_t* create_signal_bar(lv_obj_t* parent, int x, int y) {
@@ -190,9 +231,13 @@ void update_signal_bars(int num_visible) {
                 bar_color = get_bar_color(i);
             }
             
-            lv_obj_set_style_bg_color(signal_bars[i], lv_color_hex(bar_color), LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_clear_flag(signal_bars[i], LV_OBJ_FLAG_HIDDEN);
-        } else {
+            // setting a style property invalidates the bar, so skip it when nothing changed
+            lv_color_t c = lv_color_hex(bar_color);
+            if (lv_obj_get_style_bg_color(signal_bars[i], LV_PART_MAIN).full != c.full) {
+                lv_obj_set_style_bg_color(signal_bars[i], c, LV_PART_MAIN | LV_STATE_DEFAULT);
+            }
+            if (lv_obj_has_flag(signal_bars[i], LV_OBJ_FLAG_HIDDEN)) lv_obj_clear_flag(signal_bars[i], LV_OBJ_FLAG_HIDDEN);
+        } else if (!lv_obj_has_flag(signal_bars[i], LV_OBJ_FLAG_HIDDEN)) {
             lv_obj_add_flag(signal_bars[i], LV_OBJ_FLAG_HIDDEN);
         }
     }
@@ -233,13 +278,14 @@ void create_screen_main() {
         lv_obj_t *parent_obj = obj;
         // prioalertfreq
         {
-            lv_obj_t *obj = lv_label_create(parent_obj);
+            // drawn from pre-blended tiles: one atlas per colour it is shown in
+            glyph_atlas_build(&ui_font_alarmclock_112, lv_color_hex(default_color));
+            glyph_atlas_build(&ui_font_alarmclock_112, lv_color_hex(gray_color));
+
+            lv_obj_t *obj = atlas_label_create(parent_obj, &ui_font_alarmclock_112);
             objects.prioalertfreq = obj;
             lv_obj_set_pos(obj, 120, 341);
-            lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-            lv_label_set_text(obj, "");
-            lv_obj_set_style_text_font(obj, &ui_font_alarmclock_112, LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_text_color(obj, lv_color_hex(default_color), LV_PART_MAIN | LV_STATE_DEFAULT);
+            add_style_alert_color(obj);
         }
         // CREATE FLEX CONTAINER FOR STATUS ICONS
         {
@@ -399,7 +445,7 @@ void create_screen_main() {
             lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
             lv_label_set_text(obj, "");
             lv_obj_set_style_text_font(obj, &ui_font_alarmclock_128, LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_text_color(obj, lv_color_hex(default_color), LV_PART_MAIN | LV_STATE_DEFAULT);
+            add_style_alert_color(obj);
             lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
 
             // Create the black "3" overlay
@@ -420,7 +466,7 @@ void create_screen_main() {
             lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
             lv_label_set_text(obj, "");
             lv_obj_set_style_text_font(obj, &ui_font_alarmclock_128, LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_text_color(obj, lv_color_hex(default_color), LV_PART_MAIN | LV_STATE_DEFAULT);
+            add_style_alert_color(obj);
             lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
         }
         // alert_table
@@ -479,8 +525,8 @@ void create_screen_main() {
         { 
             lv_obj_t *obj = lv_img_create(objects.arrow_container);
             objects.front_arrow = obj;
-            lv_img_dsc_t *psram_img = allocate_image_in_psram(&img_arrow_front);
-            lv_img_set_src(obj, psram_img);
+            lv_img_set_src(obj, rle_img_get(&img_arrow_front, arrow_mask_palette));
+            add_style_alert_color(obj);
             //lv_obj_align(obj, LV_ALIGN_CENTER, -24, -70);
             lv_obj_set_pos(obj, 0, 0);
             lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
@@ -489,8 +535,8 @@ void create_screen_main() {
         {
             lv_obj_t *obj = lv_img_create(objects.arrow_container);
             objects.side_arrow = obj;
-            lv_img_dsc_t *psram_img = allocate_image_in_psram(&img_arrow_side);
-            lv_img_set_src(obj, psram_img);
+            lv_img_set_src(obj, rle_img_get(&img_arrow_side, arrow_mask_palette));
+            add_style_alert_color(obj);
             //lv_obj_align(obj, LV_ALIGN_CENTER, -24, 0);
             lv_obj_set_pos(obj, 0, 90);
             lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
@@ -499,8 +545,8 @@ void create_screen_main() {
         {
             lv_obj_t *obj = lv_img_create(objects.arrow_container);
             objects.rear_arrow = obj;
-            lv_img_dsc_t *psram_img = allocate_image_in_psram(&img_arrow_rear);
-            lv_img_set_src(obj, psram_img);
+            lv_img_set_src(obj, rle_img_get(&img_arrow_rear, arrow_mask_palette));
+            add_style_alert_color(obj);
             //lv_obj_align(obj, LV_ALIGN_CENTER, -24, 50);
             lv_obj_set_pos(obj, 0, 140);
             lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
@@ -529,7 +575,7 @@ void create_screen_main() {
             lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
             lv_label_set_text(obj, "");
             lv_obj_set_style_text_font(obj, &ui_font_alarmclock_128, LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_text_color(obj, lv_color_hex(default_color), LV_PART_MAIN | LV_STATE_DEFAULT);
+            add_style_alert_color(obj);
             lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
         }
         // band_ka
@@ -540,7 +586,7 @@ void create_screen_main() {
             lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
             lv_label_set_text(obj, "KA");
             lv_obj_set_style_text_font(obj, &ui_font_alarmclock_36, LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_text_color(obj, lv_color_hex(default_color), LV_PART_MAIN | LV_STATE_DEFAULT);
+            add_style_alert_color(obj);
             lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
         }
         // band_k
@@ -551,7 +597,7 @@ void create_screen_main() {
             lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
             lv_label_set_text(obj, "K");
             lv_obj_set_style_text_font(obj, &ui_font_alarmclock_36, LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_text_color(obj, lv_color_hex(default_color), LV_PART_MAIN | LV_STATE_DEFAULT);
+            add_style_alert_color(obj);
             lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
         }
         // band_x
@@ -562,12 +608,12 @@ void create_screen_main() {
             lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
             lv_label_set_text(obj, "X");
             lv_obj_set_style_text_font(obj, &ui_font_alarmclock_36, LV_PART_MAIN | LV_STATE_DEFAULT);
-            lv_obj_set_style_text_color(obj, lv_color_hex(default_color), LV_PART_MAIN | LV_STATE_DEFAULT);
+            add_style_alert_color(obj);
             lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
         }
         // initialize blinking object mapping
         {   
-            //init_blinking_system();
+            init_blinking_system();
             register_blinking_image(BLINK_FRONT, objects.front_arrow);
             register_blinking_image(BLINK_SIDE, objects.side_arrow);
             register_blinking_image(BLINK_REAR, objects.rear_arrow);
@@ -691,39 +737,26 @@ void tick_status_bar() {
 }
 
 void tick_alertTable() {
-    static int lastTableSize = -1;
-    //static bool lastVisibility = false;
-    static bool lastMuteState = false;
-
-    // gather current state
-    int currentSize = get_var_alertTableSize();
+    static uint32_t lastVersion = 0;
     bool currentVisibility = get_showAlertTable();
-    bool currentMute = get_var_muted();
-    bool currentMuteGray = get_var_muteToGray();
 
-    // set visibility
-    // if (currentVisibility != lastVisibility) {
-    //     lastVisibility = currentVisibility;
+    if (currentVisibility == lv_obj_has_flag(objects.alert_table, LV_OBJ_FLAG_HIDDEN)) {
         if (currentVisibility) {
             lv_obj_clear_flag(objects.alert_table, LV_OBJ_FLAG_HIDDEN);
         } else {
             lv_obj_add_flag(objects.alert_table, LV_OBJ_FLAG_HIDDEN);
         }
-    //}
-
-    // update alert table content based on size change OR mute status change
-    if (currentVisibility && (currentSize != lastTableSize || currentMute != lastMuteState)) {
-        lastTableSize = currentSize;
-        lastMuteState = currentMute;
+    }
 
-        if (currentSize > 0) {
-            LV_LOG_INFO("update alert table content");
-            const char** frequencies = get_var_frequencies();
-            const char** directions = get_var_directions();
+    if (!currentVisibility) return;
 
-            update_alert_rows(currentSize, frequencies, currentMute, currentMuteGray);
-            update_alert_arrows(currentSize, directions, currentMute, currentMuteGray);
-        }
+    alert_row_t rows[MAX_ALERT_ROWS];
+    uint32_t version;
+    uint8_t count = get_var_alertRows(rows, MAX_ALERT_ROWS, &version);
+    if (version != lastVersion) {
+        lastVersion = version;
+        LV_LOG_INFO("update alert table content");
+        update_alert_table(rows, count);
     }
 }
 
@@ -769,7 +802,7 @@ void tick_screen_main() {
             bool new_val = get_var_arrowPrioFront();  // true if enabled
             bool is_hidden = lv_obj_has_flag(objects.front_arrow, LV_OBJ_FLAG_HIDDEN);
 
-            if (new_val == is_hidden && !blink_enabled[BLINK_FRONT]) {
+            if (new_val == is_hidden && !is_blinking(BLINK_FRONT)) {
                 LV_LOG_INFO("paint front");
                 tick_value_change_obj = objects.front_arrow;
                 new_val ? lv_obj_clear_flag(objects.front_arrow, LV_OBJ_FLAG_HIDDEN)
@@ -789,7 +822,7 @@ void tick_screen_main() {
             bool new_val = get_var_arrowPrioSide();  // true if enabled
             bool is_hidden = lv_obj_has_flag(objects.side_arrow, LV_OBJ_FLAG_HIDDEN);
 
-            if (new_val == is_hidden && !blink_enabled[BLINK_SIDE]) {
+            if (new_val == is_hidden && !is_blinking(BLINK_SIDE)) {
                 LV_LOG_INFO("paint side arrows");
                 tick_value_change_obj = objects.side_arrow;
                 new_val ? lv_obj_clear_flag(objects.side_arrow, LV_OBJ_FLAG_HIDDEN) 
@@ -802,7 +835,7 @@ void tick_screen_main() {
             bool new_val = get_var_arrowPrioRear();  // true if enabled
             bool is_hidden = lv_obj_has_flag(objects.rear_arrow, LV_OBJ_FLAG_HIDDEN);
        
-            if (new_val == is_hidden && !blink_enabled[BLINK_REAR]) {
+            if (new_val == is_hidden && !is_blinking(BLINK_REAR)) {
                 LV_LOG_INFO("paint rear");
                 tick_value_change_obj = objects.rear_arrow;
                 new_val ? lv_obj_clear_flag(objects.rear_arrow, LV_OBJ_FLAG_HIDDEN) 
@@ -813,13 +846,13 @@ void tick_screen_main() {
         // Priority Alert Frequency & Bars
         {    
             const char *new_val = get_var_prio_alert_freq();
-            const char *cur_val = lv_label_get_text(objects.prioalertfreq);
+            const char *cur_val = atlas_label_get_text(objects.prioalertfreq);
 
             if (strcmp(new_val, cur_val) != 0) {
                 tick_value_change_obj = objects.prioalertfreq;
                 if (new_val) { 
                     LV_LOG_INFO("updating prioAlert freq");
-                    lv_label_set_text(objects.prioalertfreq, new_val);
+                    atlas_label_set_text(objects.prioalertfreq, new_val);
                 }
                 tick_value_change_obj = NULL;
             } 
@@ -859,7 +892,7 @@ void tick_screen_main() {
             bool new_val = get_var_kaAlert();  // true if enabled
             bool is_hidden = lv_obj_has_flag(objects.band_ka, LV_OBJ_FLAG_HIDDEN);
 
-            if (new_val == is_hidden && !blink_images[BLINK_KA]) {
+            if (new_val == is_hidden && !is_blinking(BLINK_KA)) {
                 LV_LOG_INFO("paint ka");
                 tick_value_change_obj = objects.band_ka;
                 new_val ? lv_obj_clear_flag(objects.band_ka, LV_OBJ_FLAG_HIDDEN) 
@@ -872,7 +905,7 @@ void tick_screen_main() {
             bool new_val = get_var_kAlert(); // true if enabled
             bool is_hidden = lv_obj_has_flag(objects.band_k, LV_OBJ_FLAG_HIDDEN); // true if hidden
 
-            if (new_val == is_hidden) {
+            if (new_val == is_hidden && !is_blinking(BLINK_K)) {
                 LV_LOG_INFO("paint k");
                 tick_value_change_obj = objects.band_k;
                 if (new_val) { 
@@ -889,7 +922,7 @@ void tick_screen_main() {
             bool new_val = get_var_xAlert(); // true if enabled
             bool is_hidden = lv_obj_has_flag(objects.band_x, LV_OBJ_FLAG_HIDDEN); // true if hidden
 
-            if (new_val == is_hidden) {
+            if (new_val == is_hidden && !is_blinking(BLINK_X)) {
                 LV_LOG_INFO("paint x");
                 tick_value_change_obj = objects.band_x;
                 if (new_val) { 
@@ -955,7 +988,7 @@ void tick_screen_main() {
 
         barsCleared = true;
         set_var_showAlertTable(false);
-        lv_label_set_text(objects.prioalertfreq, "");
+        atlas_label_set_text(objects.prioalertfreq, "");
 
         idleStateSet = true;
     }
@@ -1019,7 +1052,7 @@ void tick_screen_main() {
                     LV_LOG_INFO("updating mode to %s", txt_val);
                     //lv_label_set_text(target, txt_val);
                     lv_label_set_text(target_old, "");
-                    lv_label_set_text(objects.prioalertfreq, "");
+                    atlas_label_set_text(objects.prioalertfreq, "");
 
                     if (lv_obj_has_flag(objects.default_mode, LV_OBJ_FLAG_HIDDEN)) {
                         lv_obj_clear_flag(objects.default_mode, LV_OBJ_FLAG_HIDDEN);
@@ -1754,6 +1787,35 @@ void tick_screen_dispSettings() {
     }
 }
 
+// Portrait (450x600) arrangement of the main screen. The panel is rotated with MADCTL
+// so LVGL renders natively at this resolution; only the widgets need to move.
+static void apply_portrait_layout() {
+    lv_coord_t hor = lv_disp_get_hor_res(NULL);
+    lv_coord_t ver = lv_disp_get_ver_res(NULL);
+
+    lv_obj_set_size(objects.logo_screen, hor, ver);
+    lv_obj_center(objects.v1gen2logo);
+
+    lv_obj_set_size(objects.main, hor, ver);
+    // top band: bands/bogeys, signal bars, alert table
+    lv_obj_set_pos(objects.alert_info_container, 0, 44);
+    lv_obj_set_pos(objects.prio_bar_container, 98, 60);
+    lv_obj_set_pos(objects.alert_table, 250, 44);
+    lv_obj_set_size(objects.alert_table, 192, 220);
+    // middle: arrows
+    lv_obj_align(objects.arrow_container, LV_ALIGN_TOP_MID, 0, 268);
+    // bottom: priority frequency and mode
+    lv_obj_set_pos(objects.prioalertfreq, 120, 490);
+    lv_obj_set_pos(objects.photo_image, 7, 481);
+    lv_obj_set_pos(objects.default_mode, 17, 490);
+    lv_obj_set_pos(objects.overlay_mode, 17, 490);
+    lv_obj_set_pos(objects.custom_freq_en, 60, 490);
+
+    // settings pages keep their landscape arrangement and scroll where they overflow
+    lv_obj_set_size(objects.settings, hor, ver);
+    lv_obj_set_size(objects.dispSettings, hor, ver);
+}
+
 void create_screens() {
     lv_disp_t *dispp = lv_disp_get_default();
     lv_theme_t *theme = lv_theme_default_init(dispp, lv_palette_main(LV_PALETTE_BLUE), lv_palette_main(LV_PALETTE_RED), true, LV_FONT_DEFAULT);
@@ -1764,6 +1826,10 @@ void create_screens() {
     create_screen_settings();
     create_screen_dispSettings();
 
+    if (lv_disp_get_hor_res(NULL) < lv_disp_get_ver_res(NULL)) {
+        apply_portrait_layout();
+    }
+
     //lv_obj_add_event_cb(objects.main, gesture_event_handler, LV_EVENT_GESTURE, NULL);
     lv_obj_add_event_cb(objects.settings, gesture_event_handler, LV_EVENT_GESTURE, NULL);
 
@@ -0,0 +1,169 @@
+#include <string.h>
+#include "seg7.h"
+
+typedef struct {
+    lv_coord_t digit_w;
+    lv_coord_t digit_h;
+    lv_coord_t thick;
+    lv_coord_t space;
+    uint8_t count;
+    uint8_t masks[SEG7_MAX_CELLS];
+    char text[SEG7_MAX_CELLS + 1];
+} seg7_t;
+
+static uint8_t seg7_mask(char c) {
+    switch (c) {
+        case '0': return SEG7_A | SEG7_B | SEG7_C | SEG7_D | SEG7_E | SEG7_F;
+        case '1': return SEG7_B | SEG7_C;
+        case '2': return SEG7_A | SEG7_B | SEG7_D | SEG7_E | SEG7_G;
+        case '3': return SEG7_A | SEG7_B | SEG7_C | SEG7_D | SEG7_G;
+        case '4': return SEG7_B | SEG7_C | SEG7_F | SEG7_G;
+        case '5': case 'S': return SEG7_A | SEG7_C | SEG7_D | SEG7_F | SEG7_G;
+        case '6': return SEG7_A | SEG7_C | SEG7_D | SEG7_E | SEG7_F | SEG7_G;
+        case '7': return SEG7_A | SEG7_B | SEG7_C;
+        case '8': return SEG7_A | SEG7_B | SEG7_C | SEG7_D | SEG7_E | SEG7_F | SEG7_G;
+        case '9': return SEG7_A | SEG7_B | SEG7_C | SEG7_D | SEG7_F | SEG7_G;
+        case 'A': return SEG7_A | SEG7_B | SEG7_C | SEG7_E | SEG7_F | SEG7_G;
+        case 'C': return SEG7_A | SEG7_D | SEG7_E | SEG7_F;
+        case 'c': return SEG7_D | SEG7_E | SEG7_G;
+        case 'E': return SEG7_A | SEG7_D | SEG7_E | SEG7_F | SEG7_G;
+        case 'L': return SEG7_D | SEG7_E | SEG7_F;
+        case 'R': case 'r': return SEG7_E | SEG7_G;
+        case '-': return SEG7_G;
+        case '.': return SEG7_DP;
+        default: return 0;
+    }
+}
+
+static inline lv_coord_t cell_width(const seg7_t *s, uint8_t mask) {
+    return (mask == SEG7_DP) ? s->thick * 2 : s->digit_w;
+}
+
+// rectangle of one segment relative to its cell origin
+static void segment_area(const seg7_t *s, uint8_t seg, lv_area_t *a) {
+    const lv_coord_t w = s->digit_w, h = s->digit_h, t = s->thick;
+    const lv_coord_t m1 = (h - t) / 2, m2 = m1 + t - 1;
+    switch (seg) {
+        case SEG7_A:  lv_area_set(a, t, 0, w - t - 1, t - 1); break;
+        case SEG7_B:  lv_area_set(a, w - t, t, w - 1, m1 - 1); break;
+        case SEG7_C:  lv_area_set(a, w - t, m2 + 1, w - 1, h - t - 1); break;
+        case SEG7_D:  lv_area_set(a, t, h - t, w - t - 1, h - 1); break;
+        case SEG7_E:  lv_area_set(a, 0, m2 + 1, t - 1, h - t - 1); break;
+        case SEG7_F:  lv_area_set(a, 0, t, t - 1, m1 - 1); break;
+        case SEG7_G:  lv_area_set(a, t, m1, w - t - 1, m2); break;
+        default:      lv_area_set(a, t / 2, h - t, t / 2 + t - 1, h - 1); break;
+    }
+}
+
+static void invalidate_segments(lv_obj_t *obj, const seg7_t *s, lv_coord_t x, uint8_t segs) {
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+    for (uint8_t seg = 1; seg; seg <<= 1) {
+        if (!(segs & seg)) continue;
+        lv_area_t a;
+        segment_area(s, seg, &a);
+        lv_area_move(&a, coords.x1 + x, coords.y1);
+        lv_obj_invalidate_area(obj, &a);
+    }
+}
+
+static void seg7_event_cb(lv_event_t *e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    seg7_t *s = (seg7_t *)lv_obj_get_user_data(obj);
+
+    if (code == LV_EVENT_DELETE) {
+        lv_mem_free(s);
+        lv_obj_set_user_data(obj, NULL);
+    }
+    else if (code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t *p = (lv_point_t *)lv_event_get_param(e);
+        lv_coord_t w = 0;
+        for (uint8_t i = 0; i < s->count; i++) w += cell_width(s, s->masks[i]) + s->space;
+        p->x = LV_MAX(p->x, w);
+        p->y = LV_MAX(p->y, s->digit_h);
+    }
+    else if (code == LV_EVENT_DRAW_MAIN) {
+        lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+        lv_area_t coords;
+        lv_obj_get_content_coords(obj, &coords);
+
+        lv_draw_rect_dsc_t rect_dsc;
+        lv_draw_rect_dsc_init(&rect_dsc);
+        rect_dsc.bg_color = lv_obj_get_style_text_color(obj, LV_PART_MAIN);
+        rect_dsc.bg_opa = lv_obj_get_style_text_opa(obj, LV_PART_MAIN);
+
+        lv_coord_t x = coords.x1;
+        for (uint8_t i = 0; i < s->count; i++) {
+            for (uint8_t seg = 1; seg; seg <<= 1) {
+                if (!(s->masks[i] & seg)) continue;
+                lv_area_t a;
+                segment_area(s, seg, &a);
+                lv_area_move(&a, x, coords.y1);
+                if (_lv_area_is_on(&a, draw_ctx->clip_area)) lv_draw_rect(draw_ctx, &rect_dsc, &a);
+            }
+            x += cell_width(s, s->masks[i]) + s->space;
+        }
+    }
+}
+
+lv_obj_t *seg7_create(lv_obj_t *parent, lv_coord_t digit_h) {
+    seg7_t *s = (seg7_t *)lv_mem_alloc(sizeof(seg7_t));
+    LV_ASSERT_MALLOC(s);
+    memset(s, 0, sizeof(*s));
+    s->digit_h = digit_h;
+    s->digit_w = (digit_h * 2 + 2) / 3;
+    s->thick = LV_MAX(2, digit_h / 8);
+    s->space = s->thick + 1;
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_user_data(obj, s);
+    lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_GESTURE_BUBBLE);
+    lv_obj_add_event_cb(obj, seg7_event_cb, LV_EVENT_ALL, NULL);
+    return obj;
+}
+
+void seg7_set_text(lv_obj_t *obj, const char *text) {
+    seg7_t *s = (seg7_t *)lv_obj_get_user_data(obj);
+    if (!s || !text || strcmp(s->text, text) == 0) return;
+
+    uint8_t masks[SEG7_MAX_CELLS];
+    uint8_t count = 0;
+    for (const char *c = text; *c && count < SEG7_MAX_CELLS; c++) masks[count++] = seg7_mask(*c);
+
+    // the cell layout only changes when the string shape does ("9.999" -> "10.000");
+    // otherwise repaint just the segments that toggled
+    bool same_layout = count == s->count;
+    for (uint8_t i = 0; same_layout && i < count; i++) {
+        same_layout = (masks[i] == SEG7_DP) == (s->masks[i] == SEG7_DP);
+    }
+
+    if (same_layout) {
+        lv_coord_t x = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t changed = masks[i] ^ s->masks[i];
+            if (changed) invalidate_segments(obj, s, x, changed);
+            x += cell_width(s, masks[i]) + s->space;
+        }
+    } else {
+        lv_obj_invalidate(obj);
+    }
+
+    memcpy(s->masks, masks, count);
+    s->count = count;
+    strncpy(s->text, text, SEG7_MAX_CELLS);
+    s->text[SEG7_MAX_CELLS] = '\0';
+
+    if (!same_layout) {
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+    }
+}
+
+const char *seg7_get_text(lv_obj_t *obj) {
+    seg7_t *s = (seg7_t *)lv_obj_get_user_data(obj);
+    return s ? s->text : "";
+}
@@ -0,0 +1,35 @@
+#ifndef SEG7_H
+#define SEG7_H
+
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SEG7_MAX_CELLS 12
+
+// Segment bits, a..g clockwise from the top as on a standard display, DP for '.'
+enum Seg7Segments {
+    SEG7_A = 1 << 0,
+    SEG7_B = 1 << 1,
+    SEG7_C = 1 << 2,
+    SEG7_D = 1 << 3,
+    SEG7_E = 1 << 4,
+    SEG7_F = 1 << 5,
+    SEG7_G = 1 << 6,
+    SEG7_DP = 1 << 7
+};
+
+// Vector 7-segment readout. Segments are filled rectangles sized from digit_h, coloured
+// with the text_color style. Setting a new value invalidates only the segments that
+// toggled, e.g. 24.125 -> 24.150 repaints parts of two digits.
+lv_obj_t *seg7_create(lv_obj_t *parent, lv_coord_t digit_h);
+void seg7_set_text(lv_obj_t *obj, const char *text);
+const char *seg7_get_text(lv_obj_t *obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
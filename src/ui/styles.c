@@ -5,3 +5,38 @@
 #include "screens.h"
 
 
+
+//
+// Style: alert_color
+//
+
+static lv_style_t *alert_color_style;
+
+lv_style_t *get_style_alert_color_MAIN_DEFAULT() {
+    if (!alert_color_style) {
+        alert_color_style = lv_mem_alloc(sizeof(lv_style_t));
+        lv_style_init(alert_color_style);
+        lv_style_set_text_color(alert_color_style, lv_color_hex(default_color));
+        lv_style_set_img_recolor(alert_color_style, lv_color_hex(default_color));
+        lv_style_set_img_recolor_opa(alert_color_style, LV_OPA_COVER);
+    }
+    return alert_color_style;
+}
+
+void add_style_alert_color(lv_obj_t *obj) {
+    lv_obj_add_style(obj, get_style_alert_color_MAIN_DEFAULT(), LV_PART_MAIN | LV_STATE_DEFAULT);
+}
+
+void remove_style_alert_color(lv_obj_t *obj) {
+    lv_obj_remove_style(obj, get_style_alert_color_MAIN_DEFAULT(), LV_PART_MAIN | LV_STATE_DEFAULT);
+}
+
+void set_style_alert_color(lv_color_t color) {
+    lv_style_t *style = get_style_alert_color_MAIN_DEFAULT();
+    lv_style_value_t cur;
+    if (lv_style_get_prop(style, LV_STYLE_TEXT_COLOR, &cur) == LV_RES_OK && cur.color.full == color.full) return;
+
+    lv_style_set_text_color(style, color);
+    lv_style_set_img_recolor(style, color);
+    lv_obj_report_style_change(style);
+}
@@ -7,10 +7,17 @@
 extern "C" {
 #endif
 
+// Style: alert_color
+// Text colour and image recolour of everything that turns gray on mute. Switching it
+// changes two style properties and invalidates only the objects that use it.
+lv_style_t *get_style_alert_color_MAIN_DEFAULT();
+void add_style_alert_color(lv_obj_t *obj);
+void remove_style_alert_color(lv_obj_t *obj);
+void set_style_alert_color(lv_color_t color);
 
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /*EEZ_LVGL_UI_STYLES_H*/
\ No newline at end of file
+#endif /*EEZ_LVGL_UI_STYLES_H*/
\ No newline at end of file
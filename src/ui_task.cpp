@@ -0,0 +1,125 @@
+#include "ui_task.h"
+#include "v1_config.h"
+#include <LV_Helper.h>
+#include <ui/ui.h>
+#include "ui/blinking.h"
+#include "ui/actions.h"
+#include "brightness.h"
+#include "web.h"
+#include "touch.h"
+
+const uint16_t uiFrameHistEdges[UI_FRAME_HIST_BUCKETS - 1] = { 4, 8, 16, 24, 33, 50, 100 };
+
+static portMUX_TYPE uiStatsMux = portMUX_INITIALIZER_UNLOCKED;
+static FrameStats frameStats = {};
+
+static portMUX_TYPE popupMux = portMUX_INITIALIZER_UNLOCKED;
+static char pendingPopup[48];
+static volatile bool popupPending = false;
+
+void requestPopup(const char *msg)
+{
+  portENTER_CRITICAL(&popupMux);
+  strlcpy(pendingPopup, msg, sizeof(pendingPopup));
+  popupPending = true;
+  portEXIT_CRITICAL(&popupMux);
+}
+
+void getFrameStats(FrameStats &out)
+{
+  portENTER_CRITICAL(&uiStatsMux);
+  out = frameStats;
+  portEXIT_CRITICAL(&uiStatsMux);
+}
+
+static void recordFrame(uint32_t ms)
+{
+  uint8_t bucket = 0;
+  while (bucket < UI_FRAME_HIST_BUCKETS - 1 && ms >= uiFrameHistEdges[bucket]) bucket++;
+
+  portENTER_CRITICAL(&uiStatsMux);
+  frameStats.frames++;
+  frameStats.hist[bucket]++;
+  if (ms > UI_FRAME_BUDGET_MS) frameStats.overruns++;
+  if (ms > frameStats.maxMs) frameStats.maxMs = ms;
+  portEXIT_CRITICAL(&uiStatsMux);
+}
+
+static void showPendingPopup()
+{
+  if (!popupPending) return;
+
+  char msg[sizeof(pendingPopup)];
+  portENTER_CRITICAL(&popupMux);
+  memcpy(msg, pendingPopup, sizeof(msg));
+  popupPending = false;
+  portEXIT_CRITICAL(&popupMux);
+
+  show_popup(msg);
+}
+
+// Sole owner of LVGL after setup(). Runs on a fixed UI_FRAME_BUDGET_MS cadence at a
+// priority above loop(), so BLE handshakes and their delays there can no longer stall a
+// frame. The alert table refresh is the deferrable part of a frame and is pushed to the
+// next one when the previous frame ran over budget.
+static void uiTask(void *pvParameters)
+{
+  TickType_t lastWake = xTaskGetTickCount();
+  uint32_t lastTableTick = 0;
+  uint32_t lastOverrunLog = 0;
+  bool lastFrameOver = false;
+
+  for (;;) {
+    uint32_t start = millis();
+
+    if (!lastFrameOver && start - lastTableTick >= UI_TABLE_INTERVAL_MS) {
+      lastTableTick = start;
+      tick_alertTable();
+    }
+
+    if (displayBenchmarkRequested) {
+      displayBenchmarkRequested = false;
+      stats.displayFps = runLvglBenchmark(LVGL_BENCHMARK_FRAMES);
+      takeLvglTeWaitUs();
+      char msg[48];
+      snprintf(msg, sizeof(msg), "%.1f FPS (%s)", stats.displayFps, getLvglBufferModeName());
+      show_popup(msg);
+      lastWake = xTaskGetTickCount();
+      continue;
+    }
+
+    dispatchTouchEvents();
+    showPendingPopup();
+    applyPendingBrightness();
+    ui_tick();
+    updateLvglRefreshRate(alertPresent || is_blinking_active() || lv_anim_count_running() > 0 ||
+                          lv_disp_get_inactive_time(NULL) < 5000);
+    lv_task_handler();
+
+    // the wait for the panel's TE edge is vsync, not work; a redraw spends up to
+    // LVGL_TE_TIMEOUT_MS there, so it is left out of the budget and the histogram
+    uint32_t teWaitMs = takeLvglTeWaitUs() / 1000;
+    uint32_t total = millis() - start;
+    uint32_t elapsed = total > teWaitMs ? total - teWaitMs : 0;
+    recordFrame(elapsed);
+    lastFrameOver = elapsed > UI_FRAME_BUDGET_MS;
+
+    if (lastFrameOver) {
+      if (start - lastOverrunLog > 5000) {
+        FrameStats fs;
+        getFrameStats(fs);
+        Serial.printf("UI: frame %u ms over %u ms budget (%u/%u frames over, max %u ms)\n",
+                      elapsed, UI_FRAME_BUDGET_MS, fs.overruns, fs.frames, fs.maxMs);
+        lastOverrunLog = start;
+      }
+      // don't try to catch up with back-to-back frames
+      lastWake = xTaskGetTickCount();
+    }
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(UI_FRAME_BUDGET_MS));
+  }
+}
+
+void startUiTask()
+{
+  xTaskCreatePinnedToCore(uiTask, "UITask", UI_TASK_STACK, NULL, UI_TASK_PRIORITY, NULL, UI_TASK_CORE);
+}
@@ -0,0 +1,28 @@
+#ifndef UI_TASK_H
+#define UI_TASK_H
+
+#include <Arduino.h>
+
+#define UI_TASK_CORE 1
+#define UI_TASK_PRIORITY 3        // above loop() (1), which now only runs BLE/config work
+#define UI_TASK_STACK 8192
+#define UI_FRAME_BUDGET_MS 16
+#define UI_TABLE_INTERVAL_MS 250
+#define UI_FRAME_HIST_BUCKETS 8
+
+// Frame time histogram, the wait for the panel's TE edge left out; bucket i counts frames
+// shorter than uiFrameHistEdges[i] ms, the last bucket everything at or above the final edge.
+struct FrameStats {
+  uint32_t frames;
+  uint32_t overruns;
+  uint32_t maxMs;
+  uint32_t hist[UI_FRAME_HIST_BUCKETS];
+};
+
+extern const uint16_t uiFrameHistEdges[UI_FRAME_HIST_BUCKETS - 1];
+
+void startUiTask();
+void getFrameStats(FrameStats &out);
+void requestPopup(const char *msg);
+
+#endif // UI_TASK_H
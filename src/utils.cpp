@@ -8,13 +8,13 @@
 #include "math.h"
 #include "time.h"
 #include "ble.h"
+#include "touch.h"
+#include "v1_cmd.h"
 
 std::string v1LogicMode = "";
 std::string prioAlertFreq = "START";
 std::string photoType = "";
 const char* tableFreqs[MAX_ALERTS];
-const char* frequency_ptrs[MAX_ALERTS];
-const char* direction_ptrs[MAX_ALERTS]; 
 int alertCount = 0;
 int prio_bars = 0;
 int alertTableSize = 0;
@@ -42,7 +42,7 @@ void checkProximityForMute(double currentLat, double currentLon) {
 
         if (distance <= MUTING_RADIUS_KM) {
             Serial.println("Auto-mute activated!");
-            clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqMuteOn(), 7, false);
+            v1Send(Packet::reqMuteOn(), V1_CMD_MUTE);
             return;
         }
     }
@@ -227,22 +227,9 @@ extern "C" bool get_var_usev1cle() {
     return settings.useV1LE;
 }
 
-extern "C" void main_press_handler(lv_event_t * e) {
-
-    static bool long_press_detected = false;
-    lv_event_code_t code = lv_event_get_code(e);
-    lv_indev_t * indev = lv_indev_get_act();
-
-    if (!indev) {
-        //LV_LOG_WARN("No active input device!");
-        return;
-    }
-
-    lv_dir_t gesture = lv_indev_get_gesture_dir(indev);
-
-    if (code == LV_EVENT_LONG_PRESSED) {
+void handleTouchEvent(const TouchEvent &ev) {
+    if (ev.type == TOUCH_LONG_PRESS) {
         LV_LOG_INFO("long press detected");
-        long_press_detected = true;
         Serial.println("long press detected");
         uint8_t newMode;
 
@@ -262,7 +249,7 @@ extern "C" void main_press_handler(lv_event_t * e) {
             Serial.printf("Changing mode from %d to: %d\n", globalConfig.rawMode, newMode);
             show_popup("Changing Mode...");
 
-            clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqChangeMode(newMode), 8, false);
+            v1Send(Packet::reqChangeMode(newMode), V1_CMD_USER);
             needsMode = true;
           }
 
@@ -283,32 +270,27 @@ extern "C" void main_press_handler(lv_event_t * e) {
         }
         */
     }
-    else if (code == LV_EVENT_CLICKED && !long_press_detected) {
-        if (gesture == LV_DIR_LEFT) {
-            LV_LOG_INFO("Swipe Left - Go to Settings");
-            lv_scr_load_anim(objects.settings, LV_SCR_LOAD_ANIM_MOVE_LEFT, 100, 0, false);
-            loadScreen(SCREEN_ID_SETTINGS);
-        } 
-        else if (gesture == LV_DIR_RIGHT) {
-            LV_LOG_INFO("Swipe Right - Go to Main Screen");
-            lv_scr_load_anim(objects.main, LV_SCR_LOAD_ANIM_MOVE_RIGHT, 100, 0, false);
-            loadScreen(SCREEN_ID_MAIN);
-        }
-        else if (alertPresent) {
-            LV_LOG_INFO("requesting mute via short press");
-            Serial.println("requesting mute via short press");
-            if (clientWriteCharacteristic) {
-                clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqMuteOn(), 7, false);
-                delay(20);
-                show_popup("V1 Muted");
-            } else {
-                LV_LOG_WARN("BLE characteristic is NULL, cannot send mute command");
-            }
+    else if (ev.type == TOUCH_SWIPE_LEFT) {
+        LV_LOG_INFO("Swipe Left - Go to Settings");
+        lv_scr_load_anim(objects.settings, LV_SCR_LOAD_ANIM_MOVE_LEFT, 100, 0, false);
+        loadScreen(SCREEN_ID_SETTINGS);
+    }
+    else if (ev.type == TOUCH_SWIPE_RIGHT) {
+        LV_LOG_INFO("Swipe Right - Go to Main Screen");
+        lv_scr_load_anim(objects.main, LV_SCR_LOAD_ANIM_MOVE_RIGHT, 100, 0, false);
+        loadScreen(SCREEN_ID_MAIN);
+    }
+    else if (ev.type == TOUCH_TAP && alertPresent) {
+        LV_LOG_INFO("requesting mute via short press");
+        Serial.println("requesting mute via short press");
+        if (clientWriteCharacteristic) {
+            v1Send(Packet::reqMuteOn(), V1_CMD_MUTE);
+            recordTouchMute(ev);
+            show_popup("V1 Muted");
+        } else {
+            LV_LOG_WARN("BLE characteristic is NULL, cannot send mute command");
         }
     }
-    else if (code == LV_EVENT_RELEASED) {
-        long_press_detected = false;
-    }
 }
 
 extern "C" bool get_var_alertPresent() {
@@ -443,6 +425,31 @@ extern "C" const char *get_var_prio_alert_freq() {
     return prioAlertFreq.c_str();
 }
 
+// "00".."99", so the MHz digits are copied two at a time
+static const char digitPairs[] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+// 24125 -> "24.125" in integer math; buf needs room for 7 chars. Returns the length.
+extern "C" uint8_t formatFreqMhz(uint16_t mhz, char *buf) {
+    uint16_t ghz = mhz / 1000;
+    uint16_t frac = mhz % 1000;
+    char *p = buf;
+
+    if (ghz >= 10) {
+        memcpy(p, &digitPairs[ghz * 2], 2);
+        p += 2;
+    } else {
+        *p++ = '0' + ghz;
+    }
+    *p++ = '.';
+    *p++ = '0' + frac / 100;
+    memcpy(p, &digitPairs[(frac % 100) * 2], 2);
+    p += 2;
+    *p = '\0';
+    return p - buf;
+}
+
 extern "C" void set_var_prio_alert_freq(const char *value) {
     prioAlertFreq = value;
 }
@@ -463,41 +470,46 @@ extern "C" uint8_t get_var_alertCount() {
     return alertCount;
 }
 
+static portMUX_TYPE alertRowsMux = portMUX_INITIALIZER_UNLOCKED;
+static alert_row_t alertRows[MAX_ALERTS];
+static uint8_t alertRowCount = 0;
+static uint32_t alertRowsVersion = 0;
+
+// Flattens the decoded table into rows keyed by (frequency, direction). The version only
+// moves when the rows actually differ, so the UI can skip unchanged packets outright.
 void set_var_frequencies(const std::vector<AlertTableData>& alertDataList) {
-    static char alert_frequencies[MAX_ALERTS][16];
-    static char alert_directions[MAX_ALERTS][16];
+    alert_row_t rows[MAX_ALERTS];
+    uint8_t count = 0;
 
-    int index = 0;
     for (const auto& alertData : alertDataList) {
-        constexpr int MAX_FREQ_COUNT = 4;
-        //Serial.printf("Alert #%d - alertCount: %d, freqCount: %d\n", index + 1, alertData.alertCount, alertData.freqCount);
-
-        for (int i = 0; i < alertData.freqCount && i < MAX_FREQ_COUNT && index < MAX_ALERTS; i++) {
-            snprintf(alert_frequencies[index], sizeof(alert_frequencies[index]), "%.3f", alertData.frequencies[i]);
-            frequency_ptrs[index] = alert_frequencies[index];
-
-            strncpy(alert_directions[index], alertData.direction[i], sizeof(alert_directions[index]) - 1);
-            alert_directions[index][sizeof(alert_directions[index]) - 1] = '\0';
-            direction_ptrs[index] = alert_directions[index];
-
-            //Serial.printf(" -> Freq[%d]: %s, Dir[%d]: %s\n", i, alert_frequencies[index], i, alert_directions[index]);
-
-            index++;
+        for (int i = 0; i < alertData.freqCount && count < MAX_ALERTS; i++) {
+            rows[count].freq_mhz = alertData.freqMhz[i];
+            rows[count].dir = alertData.dir[i];
+            rows[count].hash = alert_row_hash(rows[count].freq_mhz, rows[count].dir);
+            count++;
         }
     }
 
-    if (index < MAX_ALERTS) {
-        frequency_ptrs[index] = nullptr;
-        direction_ptrs[index] = nullptr;
+    portENTER_CRITICAL(&alertRowsMux);
+    bool changed = count != alertRowCount;
+    for (uint8_t i = 0; i < count && !changed; i++) {
+        changed = rows[i].hash != alertRows[i].hash;
     }
+    if (changed) {
+        memcpy(alertRows, rows, count * sizeof(alert_row_t));
+        alertRowCount = count;
+        alertRowsVersion++;
+    }
+    portEXIT_CRITICAL(&alertRowsMux);
 }
 
-extern "C" const char** get_var_frequencies() {
-    return frequency_ptrs;
-}
-
-extern "C" const char** get_var_directions() {
-    return direction_ptrs;
+extern "C" uint8_t get_var_alertRows(alert_row_t *rows, uint8_t max, uint32_t *version) {
+    portENTER_CRITICAL(&alertRowsMux);
+    uint8_t count = alertRowCount < max ? alertRowCount : max;
+    memcpy(rows, alertRows, count * sizeof(alert_row_t));
+    *version = alertRowsVersion;
+    portEXIT_CRITICAL(&alertRowsMux);
+    return count;
 }
 
 // do I need this if I use an extern? just implement a getter?
@@ -641,10 +653,9 @@ void processingTask(void *pvParameters) {
             if (received.length == 0) {Serial.println("error, packet length of 0"); continue; }
             //Serial.printf("Received packet, len: %d, first byte: 0x%02X\n", received.length, received.data[0]);
 
-            // Convert back to vector or pass the raw array to your decoder
-            std::vector<uint8_t> vec(received.data, received.data + received.length);
-            
-            PacketDecoder decoder(vec);
+            if (!v1AcceptFrame(received.data, received.length)) continue;
+
+            PacketDecoder decoder(received.data, received.length);
             decoder.decode_v2(settings.lowSpeedThreshold, 20);
             //Serial.printf("Decode time: %lu ms\n", millis() - start);
         }
@@ -654,9 +665,9 @@ void processingTask(void *pvParameters) {
 void displayTestTask(void *pvParameters) {
     Serial.println("Test Task Started");
     const std::vector<std::vector<uint8_t>> syntheticPackets = {
-        {0xAA, 0xD6, 0xEA, 0x43, 0x07, 0x13, 0x29, 0x1D, 0x21, 0x85, 0x88, 0x00, 0xE8, 0xAB},
-        {0xAA, 0xD6, 0xEA, 0x43, 0x07, 0x23, 0x5E, 0x56, 0x92, 0x83, 0x24, 0x00, 0x00, 0xAB}, // bit 11 swap to 0x04 for photoRadar
-        {0xAA, 0xD6, 0xEA, 0x43, 0x07, 0x33, 0x87, 0x8C, 0xB6, 0x81, 0x22, 0x80, 0x30, 0xAB},
+        {0xAA, 0xD6, 0xEA, 0x43, 0x08, 0x13, 0x29, 0x1D, 0x21, 0x85, 0x88, 0x00, 0x3C, 0xAB},
+        {0xAA, 0xD6, 0xEA, 0x43, 0x08, 0x23, 0x5E, 0x56, 0x92, 0x83, 0x24, 0x00, 0xC5, 0xAB}, // bit 11 swap to 0x04 for photoRadar
+        {0xAA, 0xD6, 0xEA, 0x43, 0x08, 0x33, 0x87, 0x8C, 0xB6, 0x81, 0x22, 0x80, 0xD4, 0xAB},
         //{0xAA, 0xD8, 0xEA, 0x31, 0x09, 0x4F, 0x00, 0x07, 0x28, 0x28, 0x10, 0x00, 0x00, 0x34, 0xAB}, // X band
         {0xAA, 0xD8, 0xEA, 0x31, 0x09, 0x4F, 0x4F, 0x3F, 0x22, 0x00, 0x50, 0x00, 0x35, 0x2A, 0xAB}, // Ka band - Prio + Blink
         {0xAA, 0xD8, 0xEA, 0x31, 0x09, 0x4F, 0x4F, 0x0F, 0x24, 0x24, 0x50, 0x00, 0x35, 0x20, 0xAB}, // K band - front
@@ -682,7 +693,7 @@ void displayTestTask(void *pvParameters) {
         }
         // Wait 1.5 seconds, then insert an "all clear"
         vTaskDelay(pdMS_TO_TICKS(1500));
-        const uint8_t clearBytes[] = {0xAA, 0xD8, 0xEA, 0x43, 0x07, 0x00, 0x00, 0x00, 0x00, 0x2C, 0xCC, 0x43, 0x51, 0xAB};        
+        const uint8_t clearBytes[] = {0xAA, 0xD8, 0xEA, 0x43, 0x08, 0x00, 0x00, 0x00, 0x00, 0x2C, 0xCC, 0x43, 0xF2, 0xAB};        
         RadarPacket clearPacket;
         clearPacket.length = sizeof(clearBytes);
         memcpy(clearPacket.data, clearBytes, clearPacket.length);
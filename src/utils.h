@@ -19,7 +19,6 @@ void processingTask(void *pvParameters);
 
 //double haversineDistance(double lat1, double lon1, double lat2, double lon2);
 const char *getVersion();
-void main_press_handler(lv_event_t * e);
 bool get_var_proxyConnected();
 bool get_var_customFreqEnabled();
 void set_var_bt_connected(bool value);
@@ -79,14 +78,28 @@ void set_var_speedThreshold(int value);
 void set_var_prioBars(int value);
 int get_var_prioBars();
 void set_var_prio_alert_freq(const char *value);
+uint8_t formatFreqMhz(uint16_t mhz, char *buf);
 bool get_showAlertTable();
 void set_var_showAlertTable(bool value);
 void set_var_alertCount(int value);
 uint8_t get_var_alertCount();
 void set_var_alertTableSize(int value);
 int get_var_alertTableSize();
-const char** get_var_frequencies();
-const char** get_var_directions();
+
+// One alert table row: frequency in MHz (0 = laser) and a Direction value. hash identifies
+// the row's content so the table can recognise a row that only moved.
+typedef struct {
+    uint16_t freq_mhz;
+    uint8_t dir;
+    uint32_t hash;
+} alert_row_t;
+
+static inline uint32_t alert_row_hash(uint16_t freq_mhz, uint8_t dir) {
+    return (((uint32_t)freq_mhz << 8) | dir) + 1; // never 0, which marks an empty row
+}
+
+// Copies up to max rows; version changes whenever the row contents do.
+uint8_t get_var_alertRows(alert_row_t *rows, uint8_t max, uint32_t *version);
 
 bool get_var_kAlert();
 bool get_var_kaAlert();
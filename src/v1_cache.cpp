@@ -0,0 +1,134 @@
+#include "v1_cache.h"
+#include "v1_config.h"
+#include "v1_packet.h"
+#include "ble.h"
+
+// One blob per V1, keyed by serial number; "last" names the most recent one
+struct V1CacheBlob {
+  uint8_t version;
+  char revision[8];
+  uint8_t userBytes[4];
+  uint8_t hasSweeps;
+  uint8_t sweepSections;
+  uint8_t maxSweepIndex;
+  uint8_t sectionCount;
+  uint8_t sweepCount;
+  uint16_t sections[V1_CACHE_MAX_SECTIONS][2];
+  uint16_t sweeps[V1_CACHE_MAX_SWEEPS][2];
+};
+
+static Preferences cachePrefs;
+static V1CacheBlob loaded;
+static char loadedSerial[11];
+static V1CacheState cacheState = V1_CACHE_NONE;
+
+static const char *cacheStateNames[] = { "none", "loaded", "hit", "stale", "miss" };
+
+V1CacheState getV1CacheState()
+{
+  return cacheState;
+}
+
+const char *getV1CacheStateName()
+{
+  return cacheStateNames[cacheState];
+}
+
+static bool readBlob(const char *serial, V1CacheBlob &blob)
+{
+  if (cachePrefs.getBytesLength(serial) != sizeof(blob)) return false;
+  cachePrefs.getBytes(serial, &blob, sizeof(blob));
+  return blob.version == V1_CACHE_VERSION;
+}
+
+bool v1CacheLoad()
+{
+  cacheState = V1_CACHE_NONE;
+  loadedSerial[0] = '\0';
+
+  cachePrefs.begin(V1_CACHE_NAMESPACE, true);
+  bool ok = cachePrefs.getString("last", loadedSerial, sizeof(loadedSerial)) > 0 &&
+            readBlob(loadedSerial, loaded);
+  cachePrefs.end();
+  if (!ok) return false;
+
+  applyUserBytes(loaded.userBytes);
+  if (loaded.hasSweeps) {
+    globalConfig.sweepSections = loaded.sweepSections;
+    globalConfig.maxSweepIndex = loaded.maxSweepIndex;
+    globalConfig.sections.clear();
+    for (uint8_t i = 0; i < loaded.sectionCount; i++) {
+      globalConfig.sections.emplace_back(loaded.sections[i][0], loaded.sections[i][1]);
+    }
+    globalConfig.sweeps.clear();
+    for (uint8_t i = 0; i < loaded.sweepCount; i++) {
+      globalConfig.sweeps.emplace_back(loaded.sweeps[i][0], loaded.sweeps[i][1]);
+    }
+  }
+
+  cacheState = V1_CACHE_LOADED;
+  Serial.printf("V1 cache: applied config for %s (fw %s)\n", loadedSerial, loaded.revision);
+  return true;
+}
+
+bool v1CacheValidate()
+{
+  if (cacheState == V1_CACHE_NONE) return false;
+
+  if (serialNumber != loadedSerial) {
+    cacheState = V1_CACHE_MISS;
+  } else if (softwareRevision != loaded.revision) {
+    cacheState = V1_CACHE_STALE;
+  } else {
+    cacheState = V1_CACHE_HIT;
+    return loaded.hasSweeps;
+  }
+
+  // the user bytes are read again anyway, but the sweeps have to go
+  Serial.printf("V1 cache: %s, expected %s fw %s, got %s fw %s\n", getV1CacheStateName(),
+                loadedSerial, loaded.revision, serialNumber.c_str(), softwareRevision.c_str());
+  resetSweepState();
+  return false;
+}
+
+void v1CacheSave()
+{
+  if (serialNumber.empty() || serialNumber.size() >= sizeof(loadedSerial)) return;
+
+  V1CacheBlob blob = {};
+  blob.version = V1_CACHE_VERSION;
+  strlcpy(blob.revision, softwareRevision.c_str(), sizeof(blob.revision));
+  memcpy(blob.userBytes, globalConfig.userBytes, sizeof(blob.userBytes));
+  blob.hasSweeps = allSweepDefinitionsReceived && sweepSectionsReceived &&
+                   globalConfig.sections.size() <= V1_CACHE_MAX_SECTIONS &&
+                   globalConfig.sweeps.size() <= V1_CACHE_MAX_SWEEPS;
+  if (blob.hasSweeps) {
+    blob.sweepSections = globalConfig.sweepSections;
+    blob.maxSweepIndex = globalConfig.maxSweepIndex;
+    blob.sectionCount = globalConfig.sections.size();
+    for (uint8_t i = 0; i < blob.sectionCount; i++) {
+      blob.sections[i][0] = globalConfig.sections[i].first;
+      blob.sections[i][1] = globalConfig.sections[i].second;
+    }
+    blob.sweepCount = globalConfig.sweeps.size();
+    for (uint8_t i = 0; i < blob.sweepCount; i++) {
+      blob.sweeps[i][0] = globalConfig.sweeps[i].first;
+      blob.sweeps[i][1] = globalConfig.sweeps[i].second;
+    }
+  }
+
+  const char *serial = serialNumber.c_str();
+  cachePrefs.begin(V1_CACHE_NAMESPACE, false);
+  V1CacheBlob stored;
+  if (!readBlob(serial, stored) || memcmp(&stored, &blob, sizeof(blob)) != 0) {
+    cachePrefs.putBytes(serial, &blob, sizeof(blob));
+    Serial.printf("V1 cache: saved config for %s\n", serial);
+  }
+  if (strcmp(loadedSerial, serial) != 0) {
+    cachePrefs.putString("last", serial);
+  }
+  cachePrefs.end();
+
+  strlcpy(loadedSerial, serial, sizeof(loadedSerial));
+  loaded = blob;
+}
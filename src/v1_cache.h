@@ -0,0 +1,30 @@
+#ifndef V1_CACHE_H
+#define V1_CACHE_H
+
+#include <Arduino.h>
+
+#define V1_CACHE_NAMESPACE "v1cache"
+#define V1_CACHE_VERSION 1
+#define V1_CACHE_MAX_SECTIONS 3
+#define V1_CACHE_MAX_SWEEPS 8
+
+enum V1CacheState : uint8_t {
+  V1_CACHE_NONE = 0,    // nothing cached for the last V1
+  V1_CACHE_LOADED,      // applied on connect, serial number not confirmed yet
+  V1_CACHE_HIT,         // same serial number and firmware
+  V1_CACHE_STALE,       // same serial number, different firmware
+  V1_CACHE_MISS         // a different V1
+};
+
+// Applies the configuration stored for the last connected V1 to globalConfig, so the
+// display is correct before the handshake has read anything back.
+bool v1CacheLoad();
+// Checks the loaded entry against the serial number and version the V1 reported.
+// Returns true when the cached sweeps can be used instead of reading them again.
+bool v1CacheValidate();
+// Stores globalConfig for the connected V1; only writes NVS when something changed.
+void v1CacheSave();
+V1CacheState getV1CacheState();
+const char *getV1CacheStateName();
+
+#endif // V1_CACHE_H
@@ -0,0 +1,194 @@
+#include "v1_cmd.h"
+#include "ble.h"
+#include "v1_config.h"
+#include "v1_packet.h"
+
+struct V1Cmd {
+  uint8_t length;
+  uint8_t tries;
+  uint32_t queuedUs;
+  uint8_t data[V1_CMD_MAX_LEN];
+};
+
+struct V1CmdQueue {
+  V1Cmd entries[V1_CMD_QUEUE_LEN];
+  uint8_t head;
+  uint8_t count;
+  bool headInFlight;        // being written right now; not to be replaced or coalesced into
+};
+
+static portMUX_TYPE cmdMux = portMUX_INITIALIZER_UNLOCKED;
+static V1CmdQueue queues[V1_CMD_PRIORITIES];
+static V1CmdStats cmdStats = {};
+static uint32_t busyUntil = 0;
+static uint32_t writtenAt[0x80];          // by request packet ID; all of them are below 0x80
+static TaskHandle_t cmdTaskHandle = NULL;
+
+static inline V1Cmd &entryAt(V1CmdQueue &q, uint8_t i)
+{
+  return q.entries[(q.head + i) % V1_CMD_QUEUE_LEN];
+}
+
+V1SendResult v1SendRaw(const uint8_t *data, size_t length, V1CmdPriority priority)
+{
+  if (length == 0 || length > V1_CMD_MAX_LEN || priority >= V1_CMD_PRIORITIES) {
+    portENTER_CRITICAL(&cmdMux);
+    cmdStats.invalid++;
+    portEXIT_CRITICAL(&cmdMux);
+    return V1_SEND_INVALID;
+  }
+
+  V1CmdQueue &q = queues[priority];
+  bool queued = true;
+
+  portENTER_CRITICAL(&cmdMux);
+  V1Cmd *slot = nullptr;
+  for (uint8_t i = q.headInFlight ? 1 : 0; i < q.count; i++) {
+    V1Cmd &queuedCmd = entryAt(q, i);
+    // an identical request is already waiting; a newer mute state overrides the older one
+    bool same = queuedCmd.length == length && memcmp(queuedCmd.data, data, length) == 0;
+    if (same || (priority == V1_CMD_MUTE && isMuteCommand(queuedCmd.data, queuedCmd.length))) {
+      slot = &queuedCmd;
+      cmdStats.coalesced++;
+      break;
+    }
+  }
+  if (!slot && q.count < V1_CMD_QUEUE_LEN) {
+    slot = &entryAt(q, q.count++);
+    slot->queuedUs = micros();
+  }
+  if (slot) {
+    slot->length = length;
+    slot->tries = 0;
+    memcpy(slot->data, data, length);
+  } else {
+    cmdStats.rejected++;
+    queued = false;
+  }
+  portEXIT_CRITICAL(&cmdMux);
+
+  if (queued && cmdTaskHandle) xTaskNotifyGive(cmdTaskHandle);
+  return queued ? V1_SEND_QUEUED : V1_SEND_FULL;
+}
+
+void v1CmdBusy(uint8_t pendingPackets)
+{
+  uint32_t backoff = V1_BUSY_BACKOFF_MS * (pendingPackets ? pendingPackets : 1);
+  if (backoff > V1_BUSY_BACKOFF_MAX_MS) backoff = V1_BUSY_BACKOFF_MAX_MS;
+
+  portENTER_CRITICAL(&cmdMux);
+  busyUntil = millis() + backoff;
+  cmdStats.busyBackoffs++;
+  portEXIT_CRITICAL(&cmdMux);
+}
+
+void v1CmdFlush()
+{
+  portENTER_CRITICAL(&cmdMux);
+  for (auto &q : queues) {
+    uint8_t keep = q.headInFlight ? 1 : 0;
+    cmdStats.flushed += q.count - keep;
+    q.count = keep;
+  }
+  portEXIT_CRITICAL(&cmdMux);
+}
+
+uint32_t v1CmdWrittenAt(uint8_t packetId)
+{
+  if (packetId >= sizeof(writtenAt) / sizeof(writtenAt[0])) return 0;
+  portENTER_CRITICAL(&cmdMux);
+  uint32_t at = writtenAt[packetId];
+  portEXIT_CRITICAL(&cmdMux);
+  return at;
+}
+
+void getV1CmdStats(V1CmdStats &out)
+{
+  portENTER_CRITICAL(&cmdMux);
+  out = cmdStats;
+  portEXIT_CRITICAL(&cmdMux);
+}
+
+// Highest-priority queued command, marked in flight and copied out for writing.
+static int8_t takeNext(V1Cmd &cmd)
+{
+  int8_t priority = -1;
+  portENTER_CRITICAL(&cmdMux);
+  for (uint8_t p = 0; p < V1_CMD_PRIORITIES; p++) {
+    if (queues[p].count > 0) {
+      queues[p].headInFlight = true;
+      cmd = entryAt(queues[p], 0);
+      priority = p;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&cmdMux);
+  return priority;
+}
+
+static void finishHead(uint8_t priority, bool written, uint32_t waitUs)
+{
+  V1CmdQueue &q = queues[priority];
+  portENTER_CRITICAL(&cmdMux);
+  V1Cmd &head = entryAt(q, 0);
+  q.headInFlight = false;
+  if (written) {
+    if (head.length > 3 && head.data[3] < sizeof(writtenAt) / sizeof(writtenAt[0])) {
+      writtenAt[head.data[3]] = millis() | 1;   // never 0, which means not written
+    }
+    cmdStats.sent[priority]++;
+    if (waitUs > cmdStats.maxWaitUs[priority]) cmdStats.maxWaitUs[priority] = waitUs;
+  } else if (++head.tries < V1_CMD_MAX_TRIES) {
+    portEXIT_CRITICAL(&cmdMux);
+    return;
+  } else {
+    cmdStats.failed++;
+  }
+  q.head = (q.head + 1) % V1_CMD_QUEUE_LEN;
+  q.count--;
+  portEXIT_CRITICAL(&cmdMux);
+}
+
+// The only writer to clientWriteCharacteristic. Mute beats user commands beats
+// polling, one write every V1_CMD_SPACING_MS, and nothing goes out while the V1 has
+// told us it is busy.
+static void v1CmdTask(void *pvParameters)
+{
+  TickType_t wait = portMAX_DELAY;
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, wait);
+    wait = portMAX_DELAY;
+
+    for (;;) {
+      int32_t busyMs = (int32_t)(busyUntil - millis());
+      if (busyMs > 0) {
+        wait = pdMS_TO_TICKS(busyMs);
+        break;
+      }
+
+      if (!bt_connected || !clientWriteCharacteristic) {
+        v1CmdFlush();
+        break;
+      }
+
+      V1Cmd cmd;
+      int8_t priority = takeNext(cmd);
+      if (priority < 0) break;
+
+      bool written = clientWriteCharacteristic->writeValue(cmd.data, cmd.length, false);
+      finishHead(priority, written, micros() - cmd.queuedUs);
+      if (!written) {
+        wait = pdMS_TO_TICKS(V1_CMD_RETRY_MS);
+        break;
+      }
+      vTaskDelay(pdMS_TO_TICKS(V1_CMD_SPACING_MS));
+    }
+  }
+}
+
+void startV1CmdScheduler()
+{
+  xTaskCreatePinnedToCore(v1CmdTask, "V1CmdTask", V1_CMD_TASK_STACK, NULL, V1_CMD_TASK_PRIORITY,
+                          &cmdTaskHandle, V1_CMD_TASK_CORE);
+}
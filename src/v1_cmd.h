@@ -0,0 +1,63 @@
+#ifndef V1_CMD_H
+#define V1_CMD_H
+
+#include <Arduino.h>
+#include <array>
+#include "v1_proto.h"
+
+#define V1_CMD_QUEUE_LEN 8           // per priority class
+#define V1_CMD_MAX_LEN 64
+#define V1_CMD_SPACING_MS 10         // gap between writes, as the old inline requests used
+#define V1_CMD_RETRY_MS 20
+#define V1_CMD_MAX_TRIES 3
+#define V1_BUSY_BACKOFF_MS 50        // per packet the V1 reports pending in infV1Busy
+#define V1_BUSY_BACKOFF_MAX_MS 500
+#define V1_CMD_TASK_CORE 0
+#define V1_CMD_TASK_PRIORITY 2
+#define V1_CMD_TASK_STACK 3072
+
+enum V1CmdPriority : uint8_t {
+  V1_CMD_MUTE = 0,      // mute/unmute, proxied ones included; a newer one replaces a queued one
+  V1_CMD_USER,          // touch, web and proxy-client commands
+  V1_CMD_POLL,          // handshake requests, battery and volume polling
+  V1_CMD_PRIORITIES
+};
+
+struct V1CmdStats {
+  uint32_t sent[V1_CMD_PRIORITIES];
+  uint32_t maxWaitUs[V1_CMD_PRIORITIES];  // queued -> written
+  uint32_t coalesced;
+  uint32_t rejected;        // not queued: class queue full
+  uint32_t invalid;         // not queued: empty, too long or no such class
+  uint32_t flushed;         // discarded on V1 disconnect
+  uint32_t failed;          // write refused V1_CMD_MAX_TRIES times
+  uint32_t busyBackoffs;
+};
+
+// reqMuteOn/reqMuteOff, which go out as V1_CMD_MUTE whoever sent them
+inline bool isMuteCommand(const uint8_t *data, size_t length)
+{
+  return length > 3 && (data[3] == PACKET_ID_REQMUTEON || data[3] == PACKET_ID_REQMUTEOFF);
+}
+
+enum V1SendResult : uint8_t {
+  V1_SEND_QUEUED = 0,
+  V1_SEND_FULL,         // class queue full; worth trying again later
+  V1_SEND_INVALID       // never going to be queued
+};
+
+// Queue an ESP packet (a frame from Packet::req*) or a raw write. Never blocks.
+V1SendResult v1SendRaw(const uint8_t *data, size_t length, V1CmdPriority priority);
+
+template <size_t N>
+inline bool v1Send(const std::array<uint8_t, N> &frame, V1CmdPriority priority)
+{
+  return v1SendRaw(frame.data(), N, priority) == V1_SEND_QUEUED;
+}
+void v1CmdBusy(uint8_t pendingPackets);
+uint32_t v1CmdWrittenAt(uint8_t packetId);   // millis() of the last write of that request, 0 = never
+void v1CmdFlush();
+void getV1CmdStats(V1CmdStats &out);
+void startV1CmdScheduler();
+
+#endif // V1_CMD_H
@@ -33,7 +33,6 @@ extern int alertTableSize;
 extern uint8_t currentSpeed;
 extern SemaphoreHandle_t xWiFiLock;
 extern SemaphoreHandle_t gpsDataMutex;
-extern SemaphoreHandle_t bleMutex;
 
 extern std::vector<std::pair<int, int>> sectionBounds;
 extern std::vector<std::pair<int, int>> sweepBounds;
@@ -112,7 +111,10 @@ enum UnitSystem : uint8_t { METRIC = 0, IMPERIAL = 1 };
 
 struct v1Settings {
   uint8_t displayOrientation;
+  uint8_t displayBufferMode;
   uint8_t brightness;
+  uint8_t nightBrightness;
+  bool autoBrightness;
   uint32_t textColor;
   std::vector<WiFiCredential> wifiCredentials;
   String localSSID;
@@ -122,6 +124,7 @@ struct v1Settings {
   bool isPortraitMode;
   bool disableBLE;
   bool proxyBLE;
+  bool proxyBatch;
   bool useV1LE;
   bool enableGPS;
   bool enableWifi;
@@ -181,6 +184,7 @@ struct Config {
     uint8_t rawMode;
     int mainVolume;
     int mutedVolume;
+    uint8_t userBytes[4];
     int sweepSections;
     int maxSweepIndex;
     std::vector<std::pair<int, int>> sections;
@@ -222,6 +226,7 @@ struct Stats {
     int btStr;
     int wifiRSSI;
     float voltage;
+    float displayFps;
 
     std::string boardType;
     uint8_t heapFrag;
@@ -282,13 +287,13 @@ extern Preferences preferences;
 extern bool isVBusIn, batteryCharging, isPortraitMode;
 extern unsigned long bootMillis;
 
-// int alertCount, float frequencies[5], std::string direction[5], int barCount, int freqCount
+// frequencies in integer MHz (0 = laser), directions as Direction values
 struct AlertTableData {
     uint8_t alertCount; // this might be spurious
     uint8_t barCount; // TODO: convert to array
     uint8_t freqCount;
-    float frequencies[MAX_ALERTS + 1];
-    const char* direction[MAX_ALERTS + 1];
+    uint16_t freqMhz[MAX_ALERTS + 1];
+    uint8_t dir[MAX_ALERTS + 1];
 };
 
 #endif // V1_CONFIG_H
\ No newline at end of file
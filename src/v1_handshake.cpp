@@ -0,0 +1,208 @@
+#include "v1_handshake.h"
+#include "v1_config.h"
+#include "ble.h"
+#include "utils.h"
+#include "v1_cache.h"
+#include "v1_cmd.h"
+#include "v1_packet.h"
+#include "v1_proto.h"
+
+struct HandshakeStep {
+  const char *name;
+  void (*request)();
+  uint8_t requestId;
+  bool *received;
+  int8_t after;         // index of the step whose answer this needs first (-1 = none)
+  bool sweep;           // part of the sweep stage, V1 Gen2 with device info only
+  uint16_t timeoutMs;
+  uint32_t queuedAt;
+  uint8_t tries;        // writes that went unanswered
+  bool queued;
+  bool slow;            // out of fast tries; still asked every HANDSHAKE_SLOW_RETRY_MS
+};
+
+#define STEP_SERIAL 0
+#define STEP_VERSION 1
+#define STEP_MAX_SWEEP_INDEX 5
+
+static HandshakeStep steps[] = {
+  { "serial number",   requestSerialNumber,        PACKET_ID_REQSERIALNUMBER,        &serialReceived,              -1,                   false, HANDSHAKE_TIMEOUT_MS },
+  { "version",         requestVersion,             PACKET_ID_REQVERSION,             &versionReceived,             -1,                   false, HANDSHAKE_TIMEOUT_MS },
+  { "volume",          requestVolume,              PACKET_ID_REQCURRENTVOLUME,       &volumeReceived,              -1,                   false, HANDSHAKE_TIMEOUT_MS },
+  { "user bytes",      requestUserBytes,           PACKET_ID_REQUSERBYTES,           &userBytesReceived,           -1,                   false, HANDSHAKE_TIMEOUT_MS },
+  { "sweep sections",  requestSweepSections,       PACKET_ID_REQSWEEPSECTIONS,       &sweepSectionsReceived,       -1,                   true,  HANDSHAKE_TIMEOUT_MS },
+  { "max sweep index", requestMaxSweepIndex,       PACKET_ID_REQMAXSWEEPINDEX,       &maxSweepIndexReceived,       -1,                   true,  HANDSHAKE_TIMEOUT_MS },
+  { "sweep defs",      requestAllSweepDefinitions, PACKET_ID_REQALLSWEEPDEFINITIONS, &allSweepDefinitionsReceived, STEP_MAX_SWEEP_INDEX, true,  HANDSHAKE_SWEEP_TIMEOUT_MS },
+};
+
+static bool running = false;
+static bool infoDone = false;
+static bool cacheChecked = false;
+static bool cacheSaved = false;
+static bool sweepsFromCache = false;
+static bool sweepCapable = false;
+static bool sweepStage = false;
+static uint32_t connectMillis = 0;
+static HandshakeStats handshakeStats = {};
+
+void handshakeConnected()
+{
+  connectMillis = millis();
+}
+
+void getHandshakeStats(HandshakeStats &out)
+{
+  out = handshakeStats;
+}
+
+// Called once the V1 notifications are subscribed. Every request whose prerequisites
+// are met goes out at once; the command scheduler paces them and the responses are
+// decoded as they arrive, so nothing waits on a fixed tick.
+void handshakeStart()
+{
+  if (settings.displayTest) return;
+
+  serialReceived = versionReceived = volumeReceived = userBytesReceived = false;
+  for (auto &step : steps) {
+    step.queuedAt = 0;
+    step.tries = 0;
+    step.queued = false;
+    step.slow = false;
+  }
+  handshakeStats = {};
+  infoDone = false;
+  cacheChecked = false;
+  cacheSaved = false;
+  sweepsFromCache = false;
+  running = true;
+
+  // queue the informational requests first, so the V1 answers them while the
+  // device information service is being read
+  for (auto &step : steps) {
+    if (!step.sweep) {
+      step.request();
+      step.queuedAt = millis();
+      step.queued = true;
+    }
+  }
+  if (!v1le) {
+    queryDeviceInfo(pClient);
+  }
+
+  // sweeps are read once per boot, and only from a V1 that reported device info;
+  // they wait for the serial number in case the config cache already has them
+  sweepCapable = !v1le && !manufacturerName.empty();
+  sweepStage = sweepCapable && !allSweepDefinitionsReceived;
+}
+
+// A request's timeout runs from when the scheduler actually wrote it, so time spent
+// queued behind other commands or an infV1Busy backoff doesn't use up its tries. A
+// request that stays unanswered drops to a slow retry rather than being abandoned; the
+// handshake reports complete without it, and picks up its answer whenever it comes.
+void handshakeTick()
+{
+  if (!running) return;
+  if (!bt_connected) {
+    running = false;
+    return;
+  }
+
+  uint32_t now = millis();
+  bool pending = false;       // still in fast retries; holds back completion
+  bool outstanding = false;   // anything unanswered, slow retries included
+
+  if (!cacheChecked && ((serialReceived && versionReceived) ||
+                        steps[STEP_SERIAL].slow || steps[STEP_VERSION].slow)) {
+    cacheChecked = true;
+    if (v1CacheValidate()) {
+      if (sweepStage) Serial.println("Sweeps restored from the V1 cache");
+      sweepSectionsReceived = maxSweepIndexReceived = allSweepDefinitionsReceived = true;
+      sweepsFromCache = sweepCapable;
+    }
+    // a different V1 than the cached one clears the sweeps, so they are read again
+    sweepStage = sweepCapable && !allSweepDefinitionsReceived;
+  }
+
+  for (auto &step : steps) {
+    if ((step.sweep && !sweepStage) || *step.received) continue;
+    outstanding = true;
+    if (step.sweep && !cacheChecked) {
+      pending = true;
+      continue;
+    }
+    if (step.after >= 0 && !*steps[step.after].received) {
+      if (!steps[step.after].slow) pending = true;
+      continue;
+    }
+    if (!step.slow) pending = true;
+
+    if (!step.queued) {
+      step.request();
+      step.queuedAt = now;
+      step.queued = true;
+      continue;
+    }
+
+    uint32_t writtenAt = v1CmdWrittenAt(step.requestId);
+    if (!writtenAt || (int32_t)(writtenAt - step.queuedAt) < 0) {
+      // not written yet; queue it again in case it was dropped (a duplicate still queued is coalesced)
+      if (now - step.queuedAt >= HANDSHAKE_SLOW_RETRY_MS) {
+        step.request();
+        step.queuedAt = now;
+      }
+      continue;
+    }
+
+    if (now - writtenAt < (step.slow ? HANDSHAKE_SLOW_RETRY_MS : step.timeoutMs)) continue;
+
+    if (!step.slow) {
+      if (++step.tries >= HANDSHAKE_MAX_TRIES) {
+        Serial.printf("Handshake: no %s from the V1, retrying every %u ms\n", step.name, HANDSHAKE_SLOW_RETRY_MS);
+        step.slow = true;
+        handshakeStats.failed++;
+      } else {
+        Serial.printf("Awaiting %s (attempt %d)...\n", step.name, step.tries + 1);
+      }
+    }
+    handshakeStats.retries++;
+    step.request();
+    step.queuedAt = now;
+  }
+
+  if (!infoDone && serialReceived && versionReceived && volumeReceived && userBytesReceived) {
+    Serial.println("All device information received!");
+    infoDone = true;
+    set_var_prio_alert_freq("");
+  }
+
+  if (!pending && !handshakeStats.complete) {
+    handshakeStats.complete = true;
+    handshakeStats.bootCompleteMs = now - connectMillis;
+    Serial.printf("informational boot complete: %u ms after connect (%u retries)\n",
+                  handshakeStats.bootCompleteMs, handshakeStats.retries);
+  }
+
+  // saved once the identity is known, and again when late answers finish the handshake;
+  // v1CacheSave only writes what changed
+  if (handshakeStats.complete && serialReceived && userBytesReceived && (!cacheSaved || !outstanding)) {
+    v1CacheSave();
+    cacheSaved = true;
+  }
+
+  // the app can edit custom sweeps through the proxy without a firmware change, so the
+  // cached ones stay on show while they are read again in the background; the save
+  // when that finishes keeps any difference
+  if (handshakeStats.complete && sweepsFromCache) {
+    sweepsFromCache = false;
+    beginSweepRefresh();
+    for (auto &step : steps) {
+      if (!step.sweep) continue;
+      step.queued = false;
+      step.tries = 0;
+      step.slow = false;
+    }
+    sweepStage = true;
+    outstanding = true;
+  }
+  if (!outstanding) running = false;
+}
@@ -0,0 +1,23 @@
+#ifndef V1_HANDSHAKE_H
+#define V1_HANDSHAKE_H
+
+#include <Arduino.h>
+
+#define HANDSHAKE_TIMEOUT_MS 250          // after the request is written, before it is sent again
+#define HANDSHAKE_SWEEP_TIMEOUT_MS 1000   // sweep definitions arrive as a burst of packets
+#define HANDSHAKE_MAX_TRIES 8             // unanswered writes before a request drops to slow retries
+#define HANDSHAKE_SLOW_RETRY_MS 2000
+
+struct HandshakeStats {
+  bool complete;
+  uint32_t bootCompleteMs;    // V1 connect -> last informational response
+  uint16_t retries;
+  uint8_t failed;             // requests that ran out of fast tries
+};
+
+void handshakeConnected();
+void handshakeStart();
+void handshakeTick();
+void getHandshakeStats(HandshakeStats &out);
+
+#endif // V1_HANDSHAKE_H
@@ -0,0 +1,320 @@
+#include "v1_link.h"
+#include "v1_config.h"
+#include "ble.h"
+#include "v1_handshake.h"
+
+#define LINK_RECONNECT 0x01
+#define LINK_SCAN      0x02
+#define LINK_SAVE      0x04
+
+static const char *connectMethodNames[] = { "none", "direct", "scan" };
+static const char *connModeNames[] = { "alert", "idle", "none" };
+
+struct ConnParams {
+  uint16_t minInterval;
+  uint16_t maxInterval;
+  uint16_t latency;
+  uint16_t timeout;
+};
+
+static const ConnParams connParams[V1_CONN_MODES] = {
+  { V1_CONN_ALERT_MIN_INTERVAL, V1_CONN_ALERT_MAX_INTERVAL, V1_CONN_ALERT_LATENCY, V1_CONN_ALERT_TIMEOUT },
+  { V1_CONN_IDLE_MIN_INTERVAL,  V1_CONN_IDLE_MAX_INTERVAL,  V1_CONN_IDLE_LATENCY,  V1_CONN_IDLE_TIMEOUT },
+};
+
+static Preferences linkPrefs;
+static TaskHandle_t linkTaskHandle = NULL;
+static portMUX_TYPE linkMux = portMUX_INITIALIZER_UNLOCKED;
+static V1LinkStats linkStats = {};
+
+static uint8_t knownAddr[6];
+static uint8_t knownType = 0;
+static bool knownLe = false;
+static bool known = false;
+
+static uint8_t newAddr[6];
+static uint8_t newType = 0;
+static bool newLe = false;
+
+static volatile bool connecting = false;
+static V1ConnectMethod pendingMethod = V1_CONNECT_NONE;
+static uint32_t lostAt = 0;
+static bool whitelistRound = false;
+
+static V1ConnMode connMode = V1_CONN_NONE;
+static uint32_t bookedAt = 0;
+static uint32_t switchRequestedAt = 0;
+static uint32_t lastAlertMs = 0;
+static bool switchPending = false;
+
+const char *getV1ConnectMethodName(V1ConnectMethod method)
+{
+  return connectMethodNames[method];
+}
+
+const char *getV1ConnModeName(V1ConnMode mode)
+{
+  return connModeNames[mode];
+}
+
+void getV1LinkStats(V1LinkStats &out)
+{
+  portENTER_CRITICAL(&linkMux);
+  out = linkStats;
+  portEXIT_CRITICAL(&linkMux);
+}
+
+static void notifyLink(uint32_t bits)
+{
+  if (linkTaskHandle) xTaskNotify(linkTaskHandle, bits, eSetBits);
+}
+
+static void publishAddress()
+{
+  NimBLEAddress addr(knownAddr, knownType);
+  portENTER_CRITICAL(&linkMux);
+  linkStats.known = true;
+  strlcpy(linkStats.address, addr.toString().c_str(), sizeof(linkStats.address));
+  portEXIT_CRITICAL(&linkMux);
+}
+
+static void loadAddress()
+{
+  linkPrefs.begin(V1_LINK_NAMESPACE, true);
+  known = linkPrefs.getBytes("addr", knownAddr, sizeof(knownAddr)) == sizeof(knownAddr);
+  knownType = linkPrefs.getUChar("type", 0);
+  knownLe = linkPrefs.getBool("le", false);
+  linkPrefs.end();
+
+  if (known) {
+    NimBLEDevice::whiteListAdd(NimBLEAddress(knownAddr, knownType));
+    publishAddress();
+    Serial.printf("V1 link: last V1 was %s\n", linkStats.address);
+  }
+}
+
+// Runs in the link task, NVS writes don't belong in the NimBLE host callbacks
+static void saveAddress()
+{
+  if (known) {
+    NimBLEDevice::whiteListRemove(NimBLEAddress(knownAddr, knownType));
+  }
+  memcpy(knownAddr, newAddr, sizeof(knownAddr));
+  knownType = newType;
+  knownLe = newLe;
+  known = true;
+  NimBLEDevice::whiteListAdd(NimBLEAddress(knownAddr, knownType));
+
+  linkPrefs.begin(V1_LINK_NAMESPACE, false);
+  linkPrefs.putBytes("addr", knownAddr, sizeof(knownAddr));
+  linkPrefs.putUChar("type", knownType);
+  linkPrefs.putBool("le", knownLe);
+  linkPrefs.end();
+
+  publishAddress();
+  Serial.printf("V1 link: remembered %s\n", linkStats.address);
+}
+
+static void startScan()
+{
+  NimBLEScan *scan = NimBLEDevice::getScan();
+  if (bt_connected || connecting || scan->isScanning()) return;
+
+  // with a stored address, every other round only reports the whitelisted V1; the
+  // open rounds still find a different one
+  whitelistRound = known && !whitelistRound;
+  scan->setFilterPolicy(whitelistRound ? BLE_HCI_SCAN_FILT_USE_WL : BLE_HCI_SCAN_FILT_NO_WL);
+
+  portENTER_CRITICAL(&linkMux);
+  linkStats.scans++;
+  portEXIT_CRITICAL(&linkMux);
+  scan->start(V1_SCAN_TIME_MS);
+}
+
+static void reconnect()
+{
+  if (bt_connected || connecting) return;
+
+  if (known && knownLe == settings.useV1LE) {
+    NimBLEAddress addr(knownAddr, knownType);
+    Serial.printf("V1 link: directed connect to %s\n", addr.toString().c_str());
+
+    NimBLEDevice::getScan()->stop();
+    connecting = true;
+    pendingMethod = V1_CONNECT_DIRECT;
+    v1le = knownLe;
+    if (connectV1(addr, false)) return;
+
+    connecting = false;
+    portENTER_CRITICAL(&linkMux);
+    linkStats.directFailures++;
+    portEXIT_CRITICAL(&linkMux);
+    Serial.println("V1 link: directed connect failed, scanning");
+  }
+  startScan();
+}
+
+// Adds the time since the last check to the current mode
+static void bookModeTime(uint32_t now)
+{
+  if (connMode != V1_CONN_NONE) {
+    portENTER_CRITICAL(&linkMux);
+    linkStats.modes[connMode].timeMs += now - bookedAt;
+    portEXIT_CRITICAL(&linkMux);
+  }
+  bookedAt = now;
+}
+
+static void requestMode(V1ConnMode mode, uint32_t now)
+{
+  const ConnParams &p = connParams[mode];
+  connMode = mode;
+  switchRequestedAt = now;
+
+  bool ok = pClient && pClient->updateConnParams(p.minInterval, p.maxInterval, p.latency, p.timeout);
+  switchPending = ok;
+  portENTER_CRITICAL(&linkMux);
+  linkStats.connMode = mode;
+  linkStats.modes[mode].switches++;
+  if (!ok) linkStats.modes[mode].rejected++;
+  portEXIT_CRITICAL(&linkMux);
+}
+
+// The V1 (peripheral) answers our update request, so the result shows up in the
+// connection descriptor a few connection events later.
+static void checkConnParams(uint32_t now)
+{
+  NimBLEConnInfo info = pClient->getConnInfo();
+  const ConnParams &p = connParams[connMode];
+  bool inEffect = info.getConnInterval() >= p.minInterval && info.getConnInterval() <= p.maxInterval &&
+                  info.getConnLatency() == p.latency;
+
+  uint16_t mtu = pClient->getMTU();
+  portENTER_CRITICAL(&linkMux);
+  linkStats.mtu = mtu;
+  V1ConnModeStats &m = linkStats.modes[connMode];
+  m.interval = info.getConnInterval();
+  m.latency = info.getConnLatency();
+  m.timeout = info.getConnTimeout();
+  if (switchPending && inEffect) {
+    m.lastSwitchMs = now - switchRequestedAt;
+    if (m.lastSwitchMs > m.maxSwitchMs) m.maxSwitchMs = m.lastSwitchMs;
+  }
+  portEXIT_CRITICAL(&linkMux);
+
+  if (switchPending && inEffect) {
+    switchPending = false;
+    Serial.printf("V1 link: %s mode, interval %.2f ms, latency %u\n", getV1ConnModeName(connMode),
+                  info.getConnInterval() * 1.25f, info.getConnLatency());
+  }
+}
+
+// Short interval while alerts are up or the handshake is running, long interval plus
+// peripheral latency otherwise; V1_CONN_IDLE_HOLD_MS keeps a flickering alert from
+// renegotiating every few hundred ms.
+static void updateConnMode()
+{
+  uint32_t now = millis();
+  bookModeTime(now);
+  if (!bt_connected || !pClient || connecting) {
+    if (connMode != V1_CONN_NONE) {
+      connMode = V1_CONN_NONE;
+      portENTER_CRITICAL(&linkMux);
+      linkStats.connMode = V1_CONN_NONE;
+      portEXIT_CRITICAL(&linkMux);
+    }
+    return;
+  }
+
+  HandshakeStats handshake;
+  getHandshakeStats(handshake);
+  if (alertPresent || !handshake.complete) lastAlertMs = now;
+
+  V1ConnMode wanted = now - lastAlertMs < V1_CONN_IDLE_HOLD_MS ? V1_CONN_ALERT : V1_CONN_IDLE;
+  if (wanted != connMode) {
+    requestMode(wanted, now);
+  } else {
+    checkConnParams(now);
+  }
+}
+
+static void linkTask(void *pvParameters)
+{
+  for (;;) {
+    uint32_t bits = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &bits, pdMS_TO_TICKS(V1_CONN_CHECK_MS));
+
+    if (bits & LINK_SAVE) {
+      saveAddress();
+    }
+    if (bits & LINK_RECONNECT) {
+      vTaskDelay(pdMS_TO_TICKS(V1_RECONNECT_DELAY_MS));
+      reconnect();
+    } else if (bits & LINK_SCAN) {
+      startScan();
+    }
+    updateConnMode();
+  }
+}
+
+void startV1Link()
+{
+  linkStats.connMode = V1_CONN_NONE;
+  loadAddress();
+  lostAt = millis();
+  xTaskCreatePinnedToCore(linkTask, "V1Link", V1_LINK_TASK_STACK, NULL, V1_LINK_TASK_PRIORITY,
+                          &linkTaskHandle, V1_LINK_TASK_CORE);
+  notifyLink(LINK_RECONNECT);
+}
+
+void v1LinkConnected(const NimBLEAddress &address)
+{
+  uint32_t elapsed = millis() - lostAt;
+  V1ConnectMethod method = pendingMethod;
+  connecting = false;
+  pendingMethod = V1_CONNECT_NONE;
+  lastAlertMs = millis();   // the handshake starts on the short interval
+
+  portENTER_CRITICAL(&linkMux);
+  linkStats.lastMethod = method;
+  linkStats.lastReconnectMs = elapsed;
+  if (elapsed > linkStats.maxReconnectMs) linkStats.maxReconnectMs = elapsed;
+  linkStats.connects++;
+  portEXIT_CRITICAL(&linkMux);
+  Serial.printf("V1 link: connected in %u ms (%s)\n", elapsed, getV1ConnectMethodName(method));
+
+  if (!known || knownType != address.getType() || knownLe != v1le ||
+      memcmp(knownAddr, address.getVal(), sizeof(knownAddr)) != 0) {
+    memcpy(newAddr, address.getVal(), sizeof(newAddr));
+    newType = address.getType();
+    newLe = v1le;
+    notifyLink(LINK_SAVE);
+  }
+}
+
+void v1LinkDisconnected()
+{
+  lostAt = millis();
+  notifyLink(LINK_RECONNECT);
+}
+
+// Only the asynchronous scan connects report here; a failed directed connect
+// returns to reconnect() which starts the scan itself.
+void v1LinkConnectFailed()
+{
+  if (pendingMethod != V1_CONNECT_SCAN) return;
+  connecting = false;
+  pendingMethod = V1_CONNECT_NONE;
+  notifyLink(LINK_SCAN);
+}
+
+void v1LinkScanMatch()
+{
+  connecting = true;
+  pendingMethod = V1_CONNECT_SCAN;
+}
+
+void v1LinkScanEnded()
+{
+  notifyLink(LINK_SCAN);
+}
@@ -0,0 +1,78 @@
+#ifndef V1_LINK_H
+#define V1_LINK_H
+
+#include <NimBLEDevice.h>
+
+#define V1_LINK_NAMESPACE "v1link"
+#define V1_CONNECT_TIMEOUT_MS 3000   // directed connect to the remembered V1
+#define V1_RECONNECT_DELAY_MS 100    // let NimBLE finish tearing down the old link
+#define V1_SCAN_TIME_MS 5000
+#define V1_LINK_TASK_CORE 0
+#define V1_LINK_TASK_PRIORITY 1
+#define V1_LINK_TASK_STACK 4096
+#define V1_CONN_CHECK_MS 100         // how often the link task looks at alertPresent
+#define V1_CONN_IDLE_HOLD_MS 5000    // stay fast this long after the last alert
+
+// Connection parameters in BLE units: interval 1.25 ms, supervision timeout 10 ms
+#define V1_CONN_ALERT_MIN_INTERVAL 6     // 7.5 ms
+#define V1_CONN_ALERT_MAX_INTERVAL 12    // 15 ms
+#define V1_CONN_ALERT_LATENCY 0
+#define V1_CONN_ALERT_TIMEOUT 400        // 4 s
+#define V1_CONN_IDLE_MIN_INTERVAL 60     // 75 ms
+#define V1_CONN_IDLE_MAX_INTERVAL 80     // 100 ms
+#define V1_CONN_IDLE_LATENCY 4           // the V1 may skip 4 events when it has nothing to send
+#define V1_CONN_IDLE_TIMEOUT 600         // 6 s
+
+enum V1ConnectMethod : uint8_t {
+  V1_CONNECT_NONE = 0,
+  V1_CONNECT_DIRECT,    // straight to the stored address, no scan
+  V1_CONNECT_SCAN       // found by the fallback scan
+};
+
+// Alerts (and the handshake) run on a short interval, the rest of the drive on a
+// long one with peripheral latency.
+enum V1ConnMode : uint8_t {
+  V1_CONN_ALERT = 0,
+  V1_CONN_IDLE,
+  V1_CONN_MODES,
+  V1_CONN_NONE = V1_CONN_MODES
+};
+
+struct V1ConnModeStats {
+  uint32_t timeMs;            // connected time spent in this mode
+  uint32_t switches;
+  uint32_t rejected;          // parameter updates the stack refused to start
+  uint32_t lastSwitchMs;      // request -> parameters in effect
+  uint32_t maxSwitchMs;
+  uint16_t interval;          // last negotiated, 1.25 ms units
+  uint16_t latency;
+  uint16_t timeout;           // 10 ms units
+};
+
+struct V1LinkStats {
+  bool known;                 // a V1 address is stored
+  char address[18];
+  V1ConnectMethod lastMethod;
+  uint32_t lastReconnectMs;   // boot or disconnect -> connected
+  uint32_t maxReconnectMs;
+  uint32_t connects;
+  uint16_t directFailures;
+  uint16_t scans;
+  uint16_t mtu;
+  V1ConnMode connMode;
+  V1ConnModeStats modes[V1_CONN_MODES];
+};
+
+// Starts the connection task; connects directly when a V1 address is stored and
+// falls back to a passive scan filtered on the V1 service.
+void startV1Link();
+void v1LinkConnected(const NimBLEAddress &address);
+void v1LinkDisconnected();
+void v1LinkConnectFailed();
+void v1LinkScanMatch();
+void v1LinkScanEnded();
+void getV1LinkStats(V1LinkStats &out);
+const char *getV1ConnectMethodName(V1ConnectMethod method);
+const char *getV1ConnModeName(V1ConnMode mode);
+
+#endif // V1_LINK_H
@@ -5,7 +5,7 @@
 #include "ui/ui.h"
 #include "ui/actions.h"
 #include "ui/blinking.h"
-#include <set>
+#include "v1_cmd.h"
 
 std::vector<uint8_t> lastRawInfPayload;
 bool priority, junkAlert, alertPresent, muted, remoteAudio, savvy;
@@ -22,6 +22,12 @@ Config globalConfig;
 static bool k_rcvd = false;
 static bool ka_rcvd = false;
 static bool zero_rcvd = false;
+static int sweepZeroes = 0;
+
+// set while the cached sweeps are re-read from the V1; the new definitions collect here
+// and replace globalConfig.sweeps once complete, so the cached set stays in use meanwhile
+static bool sweepRefresh = false;
+static decltype(Config::sweeps) refreshedSweeps;
 
 BandState ka_state = {false, 0};
 BandState k_state = {false, 0};
@@ -33,10 +39,68 @@ BandState side_state = {false, 0};
 BandState rear_state = {false, 0};
 
 extern void requestMute();
-uint8_t packet[10];
+using namespace v1proto;
+
+// encode<>() runs at compile time; spot-check both frame shapes against the wire format
+static constexpr ReqVersion::Frame versionFrame = encode<ReqVersion>();
+static_assert(versionFrame.size() == 7 && versionFrame[4] == 0x01 && versionFrame[5] == 0x6C, "reqVersion frame");
+static constexpr ReqChangeMode::Frame changeModeFrame = encode<ReqChangeMode>(2);
+static_assert(changeModeFrame[4] == 0x02 && changeModeFrame[5] == 0x02 && changeModeFrame[6] == 0xA4, "reqChangeMode frame");
+
+static portMUX_TYPE rxStatsMux = portMUX_INITIALIZER_UNLOCKED;
+static V1RxStats rxStats = {};
+
+// Called on every frame from the V1 before anything reads it; a frame that fails is
+// dropped whole rather than decoded from a corrupt buffer.
+bool v1AcceptFrame(const uint8_t *data, size_t length)
+{
+    uint32_t start = ESP.getCycleCount();
+    FrameCheck result = check(FrameView(data, length));
+    uint32_t cycles = ESP.getCycleCount() - start;
+    uint8_t id = length > 3 ? data[3] : PACKET_ID_NONE;
+
+    portENTER_CRITICAL(&rxStatsMux);
+    rxStats.checkCycles += cycles;
+    if (cycles > rxStats.maxCheckCycles) rxStats.maxCheckCycles = cycles;
+    if (result == FRAME_OK) {
+        rxStats.accepted++;
+    } else {
+        rxStats.rejected[result]++;
+        if (rxStats.rejectsById[id] < UINT16_MAX) rxStats.rejectsById[id]++;
+    }
+    portEXIT_CRITICAL(&rxStatsMux);
+
+    if (result != FRAME_OK) {
+        static uint32_t lastLog = 0;
+        if (millis() - lastLog > 1000) {
+            Serial.printf("V1: dropped packet 0x%02X (%u bytes): %s\n", id, length, getFrameCheckName(result));
+            lastLog = millis();
+        }
+    }
+    return result == FRAME_OK;
+}
+
+void getV1RxStats(V1RxStats &out)
+{
+    portENTER_CRITICAL(&rxStatsMux);
+    out = rxStats;
+    portEXIT_CRITICAL(&rxStatsMux);
+}
+
+const char *getFrameCheckName(FrameCheck check)
+{
+    switch (check) {
+        case FRAME_OK:            return "ok";
+        case FRAME_BAD_FRAMING:   return "framing";
+        case FRAME_BAD_LENGTH:    return "length";
+        case FRAME_BAD_CHECKSUM:  return "checksum";
+        case FRAME_SHORT_PAYLOAD: return "shortPayload";
+        default:                  return "unknown";
+    }
+}
 
-PacketDecoder::PacketDecoder(const std::vector<uint8_t>& rawpacket)
-  : rawpacket(rawpacket) {}
+PacketDecoder::PacketDecoder(const uint8_t *data, size_t length)
+  : rawpacket(data, length) {}
 
 int combineMSBLSB_v2(uint8_t msb, uint8_t lsb) {
     return (static_cast<int>(msb) << 8) | lsb;
@@ -54,46 +118,178 @@ void clearInactiveBands(uint8_t newBandData) {
     activeBands &= (lastReceivedBands | newBandData); 
 }
 
-uint8_t mapXToBars(uint8_t& value) {
-    static constexpr uint8_t thresholds[] = {0x00, 0x95, 0x9F, 0xA9, 0xB3, 0xBC, 0xC4, 0xCF, 0xFF};
-
-    for (int i = 0; i < 8; ++i) {
-        if (value <= thresholds[i]) return i;
-    }
-
-    return -1;
-}
-
-uint8_t mapKToBars(uint8_t& value) {
-    static constexpr uint8_t thresholds[] = {0x00, 0x87, 0x8F, 0x99, 0xA3, 0xAD, 0xB7, 0xC1, 0xFF};
-
-    for (int i = 0; i < 8; ++i) {
-        if (value <= thresholds[i]) return i;
-    }
-
-    return -1;
-}
-
-uint8_t mapKaToBars(uint8_t& value) {
-    static constexpr uint8_t thresholds[] = {0x00, 0x8F, 0x96, 0x9D, 0xA4, 0xAB, 0xB2, 0xB9, 0xFF};
-
-    for (int i = 0; i < 8; ++i) {
-        if (value <= thresholds[i]) return i;
+// Strength -> bars: the index of the first threshold the value does not exceed. The
+// per-band tables are expanded at compile time into 256-entry LUTs, so the alert path
+// does one load per strength instead of walking the thresholds.
+static constexpr uint8_t xThresholds[] = {0x00, 0x95, 0x9F, 0xA9, 0xB3, 0xBC, 0xC4, 0xCF, 0xFF};
+static constexpr uint8_t kThresholds[] = {0x00, 0x87, 0x8F, 0x99, 0xA3, 0xAD, 0xB7, 0xC1, 0xFF};
+static constexpr uint8_t kaThresholds[] = {0x00, 0x8F, 0x96, 0x9D, 0xA4, 0xAB, 0xB2, 0xB9, 0xFF};
+
+static constexpr uint8_t barsFor(const uint8_t *thresholds, uint8_t value, uint8_t i = 0) {
+    return (i == 8 || value <= thresholds[i]) ? i : barsFor(thresholds, value, i + 1);
+}
+
+template <size_t... I> struct BarsLut {
+    static constexpr uint8_t x[] = { barsFor(xThresholds, I)... };
+    static constexpr uint8_t k[] = { barsFor(kThresholds, I)... };
+    static constexpr uint8_t ka[] = { barsFor(kaThresholds, I)... };
+};
+template <size_t... I> constexpr uint8_t BarsLut<I...>::x[];
+template <size_t... I> constexpr uint8_t BarsLut<I...>::k[];
+template <size_t... I> constexpr uint8_t BarsLut<I...>::ka[];
+
+// 0..255 as a parameter pack without std::make_index_sequence (not in C++11)
+template <size_t N, size_t... I> struct MakeBarsLut : MakeBarsLut<N - 1, N - 1, I...> {};
+template <size_t... I> struct MakeBarsLut<0, I...> { typedef BarsLut<I...> type; };
+typedef MakeBarsLut<256>::type barsLut;
+
+static_assert(barsFor(xThresholds, 0x95) == 1 && barsFor(xThresholds, 0x96) == 2, "X bars LUT");
+static_assert(barsFor(kaThresholds, 0xFF) == 8, "Ka bars LUT");
+
+uint8_t mapXToBars(uint8_t value) { return barsLut::x[value]; }
+uint8_t mapKToBars(uint8_t value) { return barsLut::k[value]; }
+uint8_t mapKaToBars(uint8_t value) { return barsLut::ka[value]; }
+
+// Decodes the four user bytes (0x12 payload) into globalConfig. Also used to replay
+// them from the per-V1 config cache.
+void applyUserBytes(const uint8_t *userBytes) {
+    uint8_t userByteZero = userBytes[0];
+    uint8_t userByteOne = userBytes[1];
+    uint8_t userByteTwo = userBytes[2];
+    uint8_t userByteThree = userBytes[3];
+
+    memcpy(globalConfig.userBytes, userBytes, sizeof(globalConfig.userBytes));
+
+    globalConfig.xBand         = (userByteZero & 0b00000001) != 0;
+    globalConfig.kBand         = (userByteZero & 0b00000010) != 0;
+    globalConfig.kaBand        = (userByteZero & 0b00000100) != 0;
+    globalConfig.laserBand     = (userByteZero & 0b00001000) != 0;
+    globalConfig.muteTo        = (userByteZero & 0b00010000) ? "Muted Volume" : "Zero";
+    globalConfig.bogeyLockLoud = (userByteZero & 0b00100000) != 0;
+    globalConfig.rearMute      = (userByteZero & 0b01000000) != 0;
+    globalConfig.kuBand        = (userByteZero & 0b10000000) != 0;
+
+    globalConfig.euro = (userByteOne & 0b00000001) != 0;
+    globalConfig.kVerifier = (userByteOne & 0b00000010) != 0;
+    globalConfig.rearLaser = (userByteOne & 0b00000100) != 0;
+    globalConfig.customFreqEnabled = (userByteOne & 0b00001000) != 0;
+    globalConfig.kaAlwaysPrio = (userByteOne & 0b00010000) != 0;
+    globalConfig.fastLaserDetection = (userByteOne & 0b00100000) != 0;
+    globalConfig.kaSensitivityBit0 = (userByteOne & 0b01000000) ? 1 : 0;
+    globalConfig.kaSensitivityBit1 = (userByteOne & 0b10000000) ? 2 : 0;
+
+    int kaSensitivity = globalConfig.kaSensitivityBit0 + globalConfig.kaSensitivityBit1;
+    switch (kaSensitivity) {
+        case 0:
+            globalConfig.kaSensitivity = "Max Range*";
+            break;
+        case 1:
+            globalConfig.kaSensitivity = "Relaxed";
+            break;
+        case 2:
+            globalConfig.kaSensitivity = "2020 Original";
+            break;
+        case 3:
+            globalConfig.kaSensitivity = "Max Range";
+            break;
+    }
+
+    globalConfig.startupSequence = (userByteTwo & 0b00000001) != 0;
+    globalConfig.restingDisplay = (userByteTwo & 0b00000010) != 0;
+    globalConfig.bsmPlus = (userByteTwo & 0b00000100) != 0;
+    globalConfig.autoMuteBit0 = (userByteTwo & 0b00001000) ? 1 : 0;
+    globalConfig.autoMuteBit1 = (userByteTwo & 0b00010000) ? 2 : 0;
+    globalConfig.kSensitivityBit0 = (userByteTwo & 0b00100000) ? 1 : 0;
+    globalConfig.kSensitivityBit1 = (userByteTwo & 0b01000000) ? 2 : 0;
+    globalConfig.mrctPhoto = (userByteTwo & 0b10000000) != 0;
+
+    int kSensitivity = globalConfig.kSensitivityBit0 + globalConfig.kSensitivityBit1;
+
+    switch (kSensitivity) {
+        case 0:
+            globalConfig.kSensitivity = "2020 Original*";
+            break;
+        case 1:
+            globalConfig.kSensitivity = "Relaxed";
+            break;
+        case 2:
+            globalConfig.kSensitivity = "Max Range";
+            break;
+        case 3:
+            globalConfig.kSensitivity = "2020 Original";
+            break;
+    }
+
+    uint8_t autoMute = globalConfig.autoMuteBit0 + globalConfig.autoMuteBit1;
+    switch (autoMute) {
+        case 0:
+            globalConfig.autoMute = "Off*";
+            break;
+        case 1:
+            globalConfig.autoMute = "On";
+            break;
+        case 2:
+            globalConfig.autoMute = "On with Unmute 5+";
+            break;
+        case 3:
+            globalConfig.autoMute = "Off";
+            break;
+    }
+
+    globalConfig.xSensitivityBit0 = (userByteThree & 0b00000001) ? 1 : 0;
+    globalConfig.xSensitivityBit1 = (userByteThree & 0b00000010) ? 2 : 0;
+    globalConfig.driveSafe3dPhoto = (userByteThree & 0b00000100) != 0;
+    globalConfig.driveSafe3dHdPhoto = (userByteThree & 0b00001000) != 0;
+    globalConfig.redflexHaloPhoto = (userByteThree & 0b00010000) != 0;
+    globalConfig.redflexNK7Photo = (userByteThree & 0b00100000) != 0;
+    globalConfig.ekinPhoto = (userByteThree & 0b01000000) != 0;
+    globalConfig.photoVerifier = (userByteThree & 0b10000000) != 0;
+
+    int xSensitivity = globalConfig.xSensitivityBit0 + globalConfig.xSensitivityBit1;
+    switch (xSensitivity) {
+        case 0:
+            globalConfig.xSensitivity = "2020 Original*";
+            break;
+        case 1:
+            globalConfig.xSensitivity = "Relaxed";
+            break;
+        case 2:
+            globalConfig.xSensitivity = "Max Range";
+            break;
+        case 3:
+            globalConfig.xSensitivity = "2020 Original";
+            break;
+    }
+}
+
+// Forget sections and sweeps before they are requested again
+void resetSweepState() {
+    globalConfig.sections.clear();
+    globalConfig.sweeps.clear();
+    k_rcvd = ka_rcvd = zero_rcvd = false;
+    sweepZeroes = 0;
+    sweepSectionsReceived = maxSweepIndexReceived = allSweepDefinitionsReceived = false;
+    sweepRefresh = false;
+    refreshedSweeps.clear();
+}
+
+void beginSweepRefresh() {
+    k_rcvd = ka_rcvd = zero_rcvd = false;
+    sweepZeroes = 0;
+    sweepSectionsReceived = maxSweepIndexReceived = allSweepDefinitionsReceived = false;
+    refreshedSweeps.clear();
+    sweepRefresh = true;
+}
+
+void processSections_v2(const RespSweepSections& resp) {
+    globalConfig.sections.clear();
+    for (uint8_t i = 0; i < resp.count(); i++) {
+        int upperBound = resp.upperEdge(i);
+        int lowerBound = resp.lowerEdge(i);
+
+        Serial.printf("section %d: lower edge: %d, upper edge: %d\n", resp.sectionIndex(i), lowerBound, upperBound);
+        globalConfig.sections.emplace_back(lowerBound, upperBound);
     }
-
-    return -1;
-}
-
-void processSection_v2(std::vector<uint8_t> packet, uint8_t offset) {
-    uint8_t sweepDefIndexNum = packet[offset + 5];
-    uint8_t sectionCount = sweepDefIndexNum & 0b00001111;
-    uint8_t sectionIndex = (sweepDefIndexNum & 0b11110000) >> 4;
-
-    int upperBound = combineMSBLSB_v2(packet[sweepDefIndexNum + 1], packet[sweepDefIndexNum + 2]);
-    int lowerBound = combineMSBLSB_v2(packet[sweepDefIndexNum + 3], packet[sweepDefIndexNum + 4]);
-    
-    Serial.printf("section %d: lower edge: %d, upper edge: %d\n", sectionIndex, lowerBound, upperBound);
-    globalConfig.sections.emplace_back(lowerBound, upperBound);
 }
 
 BandArrowData processBandArrow_v2(uint8_t& bandArrow) {
@@ -269,12 +465,10 @@ Execute if we successfully write reqStartAlertData to clientWriteUUID
 void PacketDecoder::decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpeedThreshold, uint8_t currentSpeed) {
     unsigned long startTimeMicros = micros();
     
-    const char* dirValue = nullptr;   // Changed from std::string
     const char* bandValue = nullptr;
     int frontStrengthVal = 0;
     int rearStrengthVal = 0;
     uint16_t freqMhz = 0;
-    float freqGhz;
     Direction dir;
     Band bnd;
 
@@ -285,6 +479,10 @@ void PacketDecoder::decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpe
     AlertTableData newAlertData = {alertCountValue, {}, {}, 0, 0};
     
     for (int i = 0; i < alerts.size(); i++) {
+        freqMhz = 0;
+        dir = DIR_NONE;
+        bnd = BAND_NONE;
+
         uint8_t alertIndex = alerts[i][0];
         alertCountValue = alertIndex & 0b00001111;
         alertIndexValue = (alertIndex & 0b11110000) >> 4;
@@ -318,9 +516,9 @@ void PacketDecoder::decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpe
         }
     
         switch (bandArrow & 0b11100000) { // Mask the direction bits
-            case 0b00100000: dirValue = "FRONT"; dir = DIR_FRONT; break;
-            case 0b01000000: dirValue = "SIDE"; dir = DIR_SIDE; break;
-            case 0b10000000: dirValue = "REAR"; dir = DIR_REAR; break;
+            case 0b00100000: dir = DIR_FRONT; break;
+            case 0b01000000: dir = DIR_SIDE; break;
+            case 0b10000000: dir = DIR_REAR; break;
         }
 
         if (bnd == BAND_X && globalConfig.xBand) {
@@ -341,7 +539,6 @@ void PacketDecoder::decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpe
             uint8_t freqLSB = alerts[i][2];
     
             freqMhz = combineMSBLSB_v2(freqMSB, freqLSB);
-            freqGhz = static_cast<float>(freqMhz) / 1000.0f;
         }
 
         if (priority && bnd != BAND_LASER) {
@@ -359,9 +556,9 @@ void PacketDecoder::decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpe
             }
 
             // paint the frequency of the prio alert
-            if (freqGhz > 0) {
-                char freqStr[16];
-                snprintf(freqStr, sizeof(freqStr), "%.3f", freqGhz);
+            if (freqMhz > 0) {
+                char freqStr[8];
+                formatFreqMhz(freqMhz, freqStr);
                 set_var_prio_alert_freq(freqStr); 
             }
         }
@@ -370,8 +567,8 @@ void PacketDecoder::decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpe
             bool found = false;
             for (auto& alertData : alertDataList) {
                 if (alertData.alertCount == alertCountValue) {
-                    alertData.frequencies[alertData.freqCount] = freqGhz;
-                    alertData.direction[alertData.freqCount] = dirValue;
+                    alertData.freqMhz[alertData.freqCount] = freqMhz;
+                    alertData.dir[alertData.freqCount] = dir;
                     alertData.freqCount++;
                     found = true;
                     break;
@@ -380,15 +577,15 @@ void PacketDecoder::decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpe
             
             if (!found && !priority) {
                 AlertTableData newAlertData = {alertCountValue, {}, {}, 0, 0};
-                newAlertData.frequencies[newAlertData.freqCount] = freqGhz;
-                newAlertData.direction[newAlertData.freqCount] = dirValue;
+                newAlertData.freqMhz[newAlertData.freqCount] = freqMhz;
+                newAlertData.dir[newAlertData.freqCount] = dir;
                 newAlertData.freqCount++;
                 alertDataList.push_back(newAlertData);
             }
         }
 
         unsigned long elapsedTimeMicros = micros() - startTimeMicros;
-        if (freqGhz > 0 || bnd == BAND_LASER) {
+        if (freqMhz > 0 || bnd == BAND_LASER) {
             uint8_t strength = std::max(frontStrengthVal, rearStrengthVal);
             if (bnd == BAND_LASER) { freqMhz = 3012; strength = 6; }
 
@@ -443,7 +640,7 @@ void PacketDecoder::decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpe
             bool isDuplicate = false;
             
             for (int j = 0; j < uniqueCount; j++) {
-                if (alertData.frequencies[i] == alertData.frequencies[j]) {
+                if (alertData.freqMhz[i] == alertData.freqMhz[j]) {
                     isDuplicate = true;
                     break;
                 }
@@ -451,8 +648,8 @@ void PacketDecoder::decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpe
             
             if (!isDuplicate) {
                 if (uniqueCount != i) {
-                    alertData.frequencies[uniqueCount] = alertData.frequencies[i];
-                    alertData.direction[uniqueCount] = alertData.direction[i];
+                    alertData.freqMhz[uniqueCount] = alertData.freqMhz[i];
+                    alertData.dir[uniqueCount] = alertData.dir[i];
                 }
                 uniqueCount++;
             }
@@ -490,14 +687,15 @@ void PacketDecoder::decode_v2(int lowSpeedThreshold, uint8_t currentSpeed) {
         return;
     }
 
-    uint8_t packetID = rawpacket[3];
+    uint8_t packetID = rawpacket.id();
 
-    if (packetID == 0x31) {
-        uint8_t bandArrow1 = rawpacket[8];
-        uint8_t bandArrow2 = rawpacket[9];
-        uint8_t aux0 = rawpacket[10];
-        uint8_t aux1 = rawpacket[11];
-        uint8_t aux2 = rawpacket[12];
+    if (packetID == InfDisplayData::id) {
+        InfDisplayData display(rawpacket);
+        uint8_t bandArrow1 = display.bandArrow1();
+        uint8_t bandArrow2 = display.bandArrow2();
+        uint8_t aux0 = display.aux0();
+        uint8_t aux1 = display.aux1();
+        uint8_t aux2 = display.aux2();
 
         BandArrowData arrow1Data = processBandArrow_v2(bandArrow1);
         BandArrowData arrow2Data = processBandArrow_v2(bandArrow2);
@@ -524,13 +722,15 @@ void PacketDecoder::decode_v2(int lowSpeedThreshold, uint8_t currentSpeed) {
             needsMode = false;
         }
     } 
-    else if (packetID == 0x43) {
-        uint8_t alertC = rawpacket[5];
-        alertCountValue = alertC & 0b00001111;
-        alertIndexValue = (alertC & 0b11110000) >> 4;
+    else if (packetID == RespAlertData::id) {
+        RespAlertData alert(rawpacket);
+        alertCountValue = alert.count();
+        alertIndexValue = alert.index();
 
-        std::vector<uint8_t> payload(rawpacket.begin() + 5, rawpacket.begin() + 12);
-        alertTableRaw.push_back(payload);
+        // the table arrives one frame per alert, so its records are kept until it is complete
+        AlertRecord record;
+        memcpy(record.data(), alert.record(), record.size());
+        alertTableRaw.push_back(record);
 
         // check if the alertTable vector size is more than or equal to the tableSize (alerts.count) extracted from alertByte
         if (alertTableRaw.size() >= alertCountValue || alertTableRaw.size() == MAX_ALERTS + 1) {
@@ -539,15 +739,16 @@ void PacketDecoder::decode_v2(int lowSpeedThreshold, uint8_t currentSpeed) {
             alertTableRaw.clear();
         } 
     }
-    else if (packetID == 0x02) {
-        //std::vector<uint8_t> payload(rawpacket.begin() + 5, rawpacket.begin() + 12);
+    else if (packetID == RespVersion::id) {
+        RespVersion version(rawpacket);
+        const uint8_t *text = version.text();
 
-        char versionID        = byteToAscii(rawpacket[5]);
-        char majorVersion     = byteToAscii(rawpacket[6]);
-        char minorVersion     = byteToAscii(rawpacket[8]);
-        char revisionDigitOne = byteToAscii(rawpacket[9]);
-        char revisionDigitTwo = byteToAscii(rawpacket[10]);
-        char controlNumber    = byteToAscii(rawpacket[11]);
+        char versionID        = byteToAscii(version.component());
+        char majorVersion     = byteToAscii(text[0]);
+        char minorVersion     = byteToAscii(text[2]);
+        char revisionDigitOne = byteToAscii(text[3]);
+        char revisionDigitTwo = byteToAscii(text[4]);
+        char controlNumber    = byteToAscii(text[5]);
 
         if (versionID == 'V') {
             char versionString[8];
@@ -565,144 +766,33 @@ void PacketDecoder::decode_v2(int lowSpeedThreshold, uint8_t currentSpeed) {
             //Serial.printf("Found component: %s", versionID);
         }
     }
-    else if (packetID == 0x04) {
+    else if (packetID == RespSerialNumber::id) {
+        RespSerialNumber serial(rawpacket);
         std::string serialString;
         serialString.reserve(10);
 
         for (uint8_t i = 0; i < 10; i++) {
-            serialString += byteToAscii(rawpacket[5 + i]);
+            serialString += byteToAscii(serial.text()[i]);
         }
 
         serialNumber = serialString;
         Serial.printf("Serial Number: %s\n", serialString.c_str());
         serialReceived = true;
     }
-    else if (packetID == 0x12) {
-        uint8_t userByteZero = rawpacket[5];
-        uint8_t userByteOne = rawpacket[6];
-        uint8_t userByteTwo = rawpacket[7];
-        uint8_t userByteThree = rawpacket[8];
-
-        globalConfig.xBand         = (userByteZero & 0b00000001) != 0;
-        globalConfig.kBand         = (userByteZero & 0b00000010) != 0;
-        globalConfig.kaBand        = (userByteZero & 0b00000100) != 0;
-        globalConfig.laserBand     = (userByteZero & 0b00001000) != 0;
-        globalConfig.muteTo        = (userByteZero & 0b00010000) ? "Muted Volume" : "Zero";
-        globalConfig.bogeyLockLoud = (userByteZero & 0b00100000) != 0;
-        globalConfig.rearMute      = (userByteZero & 0b01000000) != 0;
-        globalConfig.kuBand        = (userByteZero & 0b10000000) != 0;
-
-        globalConfig.euro = (userByteOne & 0b00000001) != 0;
-        globalConfig.kVerifier = (userByteOne & 0b00000010) != 0;
-        globalConfig.rearLaser = (userByteOne & 0b00000100) != 0;
-        globalConfig.customFreqEnabled = (userByteOne & 0b00001000) != 0;
-        globalConfig.kaAlwaysPrio = (userByteOne & 0b00010000) != 0;
-        globalConfig.fastLaserDetection = (userByteOne & 0b00100000) != 0;
-        globalConfig.kaSensitivityBit0 = (userByteOne & 0b01000000) ? 1 : 0;
-        globalConfig.kaSensitivityBit1 = (userByteOne & 0b10000000) ? 2 : 0;
-
-        int kaSensitivity = globalConfig.kaSensitivityBit0 + globalConfig.kaSensitivityBit1;
-        switch (kaSensitivity) {
-            case 0:
-                globalConfig.kaSensitivity = "Max Range*";
-                break;
-            case 1:
-                globalConfig.kaSensitivity = "Relaxed";
-                break;
-            case 2:
-                globalConfig.kaSensitivity = "2020 Original";
-                break;
-            case 3:
-                globalConfig.kaSensitivity = "Max Range";
-                break;
-        }
-
-        globalConfig.startupSequence = (userByteTwo & 0b00000001) != 0;
-        globalConfig.restingDisplay = (userByteTwo & 0b00000010) != 0;
-        globalConfig.bsmPlus = (userByteTwo & 0b00000100) != 0;
-        globalConfig.autoMuteBit0 = (userByteTwo & 0b00001000) ? 1 : 0;
-        globalConfig.autoMuteBit1 = (userByteTwo & 0b00010000) ? 2 : 0;
-        globalConfig.kSensitivityBit0 = (userByteTwo & 0b00100000) ? 1 : 0;
-        globalConfig.kSensitivityBit1 = (userByteTwo & 0b01000000) ? 2 : 0;
-        globalConfig.mrctPhoto = (userByteTwo & 0b10000000) != 0;
-
-        int kSensitivity = globalConfig.kSensitivityBit0 + globalConfig.kSensitivityBit1;
-
-        switch (kSensitivity) {
-            case 0:
-                globalConfig.kSensitivity = "2020 Original*";
-                break;
-            case 1:
-                globalConfig.kSensitivity = "Relaxed";
-                break;
-            case 2:
-                globalConfig.kSensitivity = "Max Range";
-                break;
-            case 3:
-                globalConfig.kSensitivity = "2020 Original";
-                break;
-        }
-
-        uint8_t autoMute = globalConfig.autoMuteBit0 + globalConfig.autoMuteBit1;
-        switch (autoMute) {
-            case 0:
-                globalConfig.autoMute = "Off*";
-                break;
-            case 1:
-                globalConfig.autoMute = "On";
-                break;
-            case 2:
-                globalConfig.autoMute = "On with Unmute 5+";
-                break;
-            case 3:
-                globalConfig.autoMute = "Off";
-                break;
-        }
-
-        globalConfig.xSensitivityBit0 = (userByteThree & 0b00000001) ? 1 : 0;
-        globalConfig.xSensitivityBit1 = (userByteThree & 0b00000010) ? 2 : 0;
-        globalConfig.driveSafe3dPhoto = (userByteThree & 0b00000100) != 0;
-        globalConfig.driveSafe3dHdPhoto = (userByteThree & 0b00001000) != 0;
-        globalConfig.redflexHaloPhoto = (userByteThree & 0b00010000) != 0;
-        globalConfig.redflexNK7Photo = (userByteThree & 0b00100000) != 0;
-        globalConfig.ekinPhoto = (userByteThree & 0b01000000) != 0;
-        globalConfig.photoVerifier = (userByteThree & 0b10000000) != 0;
-
-        int xSensitivity = globalConfig.xSensitivityBit0 + globalConfig.xSensitivityBit1;
-        switch (xSensitivity) {
-            case 0:
-                globalConfig.xSensitivity = "2020 Original*";
-                break;
-            case 1:
-                globalConfig.xSensitivity = "Relaxed";
-                break;
-            case 2:
-                globalConfig.xSensitivity = "Max Range";
-                break;
-            case 3:
-                globalConfig.xSensitivity = "2020 Original";
-                break;
-        }
-
+    else if (packetID == RespUserBytes::id) {
+        applyUserBytes(RespUserBytes(rawpacket).bytes());
         userBytesReceived = true;
     }
-    else if (packetID == 0x17) {
-        uint8_t aux0 = rawpacket[5];
-        uint8_t msbUpper = rawpacket[6];
-        uint8_t lsbUpper = rawpacket[7];
-        uint8_t msbLower = rawpacket[8];
-        uint8_t lsbLower = rawpacket[9];
-
-        std::set<int> receivedSweeps; 
-        static int zeroes = 0;
-        
-        uint8_t sweepIndex = aux0 & 0b00111111;
+    else if (packetID == RespSweepDefinition::id) {
+        RespSweepDefinition sweep(rawpacket);
+        uint8_t sweepIndex = sweep.index();
 
-        int upperBound = combineMSBLSB_v2(msbUpper, lsbUpper);
-        int lowerBound = combineMSBLSB_v2(msbLower, lsbLower);
+        int upperBound = sweep.upperEdge();
+        int lowerBound = sweep.lowerEdge();
     
         Serial.printf("sweepIndex received: %d | lowerBound: %d | upperBound: %d\n", sweepIndex, lowerBound, upperBound);
-        auto exists = std::any_of(globalConfig.sweeps.begin(), globalConfig.sweeps.end(),
+        auto &sweeps = sweepRefresh ? refreshedSweeps : globalConfig.sweeps;
+        auto exists = std::any_of(sweeps.begin(), sweeps.end(),
         [&](const std::pair<int, int>& sweep) {
             return sweep.first == lowerBound && sweep.second == upperBound;
         });
@@ -713,7 +803,7 @@ void PacketDecoder::decode_v2(int lowSpeedThreshold, uint8_t currentSpeed) {
                 (lowerBound == 0 && upperBound == 0)) {
                 
                 if (!lowerBound == 0 || !upperBound == 0) {
-                    globalConfig.sweeps.emplace_back(lowerBound, upperBound);
+                    sweeps.emplace_back(lowerBound, upperBound);
                 }
 
                 if (lowerBound > 23800 && upperBound < 24300) {
@@ -721,209 +811,52 @@ void PacketDecoder::decode_v2(int lowSpeedThreshold, uint8_t currentSpeed) {
                 } else if (lowerBound > 33300 && upperBound < 36100) {
                     ka_rcvd = true;
                 } else if (lowerBound == 0 && upperBound == 0) {
-                    zeroes++;
+                    sweepZeroes++;
                     zero_rcvd = true;
                 }
             }
         }
-        if (globalConfig.sweeps.size() < globalConfig.maxSweepIndex - zeroes) {
-            //Serial.printf("Not all sweeps received (%d/%d), retrying...\n", globalConfig.sweeps.size(), globalConfig.maxSweepIndex + 1);
+        if (sweeps.size() < globalConfig.maxSweepIndex - sweepZeroes) {
+            //Serial.printf("Not all sweeps received (%d/%d), retrying...\n", sweeps.size(), globalConfig.maxSweepIndex + 1);
         } else {
             allSweepDefinitionsReceived = k_rcvd && ka_rcvd && zero_rcvd;
 
-            if (allSweepDefinitionsReceived) {
+            if (allSweepDefinitionsReceived && sweepRefresh) {
+                globalConfig.sweeps.swap(refreshedSweeps);
+                refreshedSweeps.clear();
+                sweepRefresh = false;
+            } else if (allSweepDefinitionsReceived) {
                 unsigned long elapsedMillis = millis() - bootMillis;
                 Serial.printf("informational boot complete: %.2f seconds\n", elapsedMillis / 1000.0);
                 Serial.printf("heap use after informational boot: %u\n", ESP.getFreeHeap());
             }
         }    
     }
-    else if (packetID == 0x20) {
-        uint8_t maxSweepIndex = rawpacket[4];
-        globalConfig.maxSweepIndex = maxSweepIndex + 1;
+    else if (packetID == RespMaxSweepIndex::id) {
+        globalConfig.maxSweepIndex = RespMaxSweepIndex(rawpacket).maxIndex() + 1;
         maxSweepIndexReceived = true;
     }
-    else if (packetID == 0x23) {
-        uint8_t value;
-        uint8_t numSections = rawpacket[3];
-
-        switch (numSections) {
-            case 6: {
-                value = 1;
-                processSection_v2(rawpacket, 0);
-                break;
-            }
-            case 11: {
-                value = 2;
-                processSection_v2(rawpacket, 0);
-                processSection_v2(rawpacket, 5);
-                break;
-            }
-            case 16: {
-                value = 3;
-                processSection_v2(rawpacket, 0);
-                processSection_v2(rawpacket, 5);
-                processSection_v2(rawpacket, 10);
-                break;
-            }
-            default: {
-                value = 0;
-            }
-        }
-        globalConfig.sweepSections = value;
+    else if (packetID == RespSweepSections::id) {
+        RespSweepSections sections(rawpacket);
+        processSections_v2(sections);
+        globalConfig.sweepSections = sections.count();
         sweepSectionsReceived = true;
     }
-    else if (packetID == 0x38) {
-        uint8_t mainV = rawpacket[5];
-        uint8_t mutedV = rawpacket[6];
-
-        globalConfig.mainVolume = mainV;
-        globalConfig.mutedVolume = mutedV;
+    else if (packetID == RespCurrentVolume::id) {
+        RespCurrentVolume volume(rawpacket);
+        globalConfig.mainVolume = volume.mainVolume();
+        globalConfig.mutedVolume = volume.mutedVolume();
         volumeReceived = true;
     }
-    else if (packetID == 0x63) {
-        uint8_t intPart = rawpacket[5];
-        uint8_t decPart = rawpacket[6];
-        stats.voltage = intPart + (decPart / 100.0f);
+    else if (packetID == RespBatteryVoltage::id) {
+        stats.voltage = RespBatteryVoltage(rawpacket).volts();
     }
-    else if (packetID == 0x66) {
-        uint8_t pendingPackets = rawpacket[4] - 1;
-        uint8_t p1 = rawpacket[5];
+    else if (packetID == InfV1Busy::id) {
+        InfV1Busy busy(rawpacket);
+        uint8_t pendingPackets = busy.pending();
+        uint8_t p1 = busy.firstPending();
         Serial.printf("infV1Busy; pending packets: %d, first packet ID: 0x%02X\n", pendingPackets, p1);
+        v1CmdBusy(pendingPackets);
     }
     return;
 }
-
-/*
-the functions below are responsible for generating and sending packets to the v1.
-calculating checksums for inbound packets incurs unnecessary overhead therefore
-is not done in any of the functions above.
-*/
-
-uint8_t Packet::calculateChecksum(const uint8_t *data, size_t length) {
-    uint8_t checksum = 0;
-    for (size_t i = 0; i < length; i++) {
-        checksum += data[i];
-    }
-    return checksum;
-}
-
-uint8_t* Packet::constructPacket(uint8_t destID, uint8_t sendID, uint8_t packetID, uint8_t *payloadData, uint8_t payloadLength, uint8_t *packet) {
-    packet[0] = PACKETSTART;
-    packet[1] = 0xD0 + destID;
-    packet[2] = 0xE0 + sendID;
-    packet[3] = packetID;
-    packet[4] = payloadLength;
-
-    if (payloadLength > 1) {
-        for (int i = 0; i < payloadLength - 1; i++) {
-            packet[5 + i] = payloadData[i];
-        }
-        packet[5 + payloadLength - 1] = calculateChecksum(packet, 5 + payloadLength - 1);
-        packet[5 + payloadLength] = PACKETEND;
-    } else {
-        packet[4] = 0x01;
-        packet[5] = calculateChecksum(packet, 5);
-        packet[6] = PACKETEND;
-    }
-    return packet;
-}
-
-uint8_t* Packet::reqTurnOffMainDisplay(uint8_t mode) {
-    uint8_t payloadData[] = {mode, mode};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    Serial.println("Sending reqTurnOffMainDisplay packet");
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQTURNOFFMAINDISPLAY, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqStartAlertData() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    Serial.println("Sending reqStartAlertData packet");
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQSTARTALERTDATA, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqVersion() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]); 
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQVERSION, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqSweepSections() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQSWEEPSECTIONS, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqMaxSweepIndex() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQMAXSWEEPINDEX, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqAllSweepDefinitions() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQALLSWEEPDEFINITIONS, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqSerialNumber() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQSERIALNUMBER, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqTurnOnMainDisplay() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    Serial.println("Sending reqTurnOnMainDisplay packet");
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQTURNONMAINDISPLAY, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqMuteOn() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQMUTEON, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqMuteOff() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQMUTEOFF, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqChangeMode(uint8_t mode) {
-    uint8_t payloadData[] = {mode, mode};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQCHANGEMODE, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqBatteryVoltage() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQBATTERYVOLTAGE, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqCurrentVolume() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQCURRENTVOLUME, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqUserBytes() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQUSERBYTES, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqSavvyStatus() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQSAVVYSTATUS, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
-
-uint8_t* Packet::reqVehicleSpeed() {
-    uint8_t payloadData[] = {0x01};
-    uint8_t payloadLength = sizeof(payloadData) / sizeof(payloadData[0]);
-    return constructPacket(DEST_V1, REMOTE_SENDER, PACKET_ID_REQVEHICLESPEED, const_cast<uint8_t*>(payloadData), payloadLength, packet);
-}
\ No newline at end of file
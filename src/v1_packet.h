@@ -4,30 +4,8 @@
 #include <string>
 #include <vector>
 #include "v1_config.h"
+#include "v1_proto.h"
 
-// Packet config
-#define PACKETSTART 0xAA
-#define PACKETEND 0xAB
-#define REQVERSION 0x01
-#define DEST_V1 0x0A // send packets to the v1 device id
-//#define DEST_V1_LE 0x06
-#define REMOTE_SENDER 0x06 // originate packets from 0x04 - "third party use"
-#define PACKET_ID_REQVERSION 0x01
-#define PACKET_ID_REQSERIALNUMBER 0x03
-#define PACKET_ID_REQUSERBYTES 0x11
-#define PACKET_ID_REQALLSWEEPDEFINITIONS 0x16
-#define PACKET_ID_REQMAXSWEEPINDEX 0x19
-#define PACKET_ID_REQSWEEPSECTIONS 0x22
-#define PACKET_ID_REQTURNOFFMAINDISPLAY 0x32
-#define PACKET_ID_REQTURNONMAINDISPLAY 0x33
-#define PACKET_ID_REQMUTEON 0x34
-#define PACKET_ID_REQMUTEOFF 0x35
-#define PACKET_ID_REQCHANGEMODE 0x36
-#define PACKET_ID_REQCURRENTVOLUME 0x37
-#define PACKET_ID_REQSTARTALERTDATA 0x41
-#define PACKET_ID_REQBATTERYVOLTAGE 0x62
-#define PACKET_ID_REQSAVVYSTATUS 0x71
-#define PACKET_ID_REQVEHICLESPEED 0x73
 #define BAND_TIMEOUT_MS 500
 
 struct BandArrowData {
@@ -128,40 +106,56 @@ extern BandState rear_state;
 void updateBandActivity(bool ka, bool k, bool x, bool laser);
 void updateArrowActivity(bool front, bool side, bool rear);
 void checkBandTimeouts();
+void applyUserBytes(const uint8_t *userBytes);
+void resetSweepState();
+void beginSweepRefresh();
+
+// Inbound frame validation, counted by reason and by packet ID
+struct V1RxStats {
+    uint32_t accepted;
+    uint32_t rejected[v1proto::FRAME_CHECKS];   // indexed by FrameCheck; FRAME_OK unused
+    uint16_t rejectsById[256];
+    uint64_t checkCycles;                        // CPU cycles spent validating, all frames
+    uint32_t maxCheckCycles;
+};
+
+bool v1AcceptFrame(const uint8_t *data, size_t length);
+void getV1RxStats(V1RxStats &out);
+const char *getFrameCheckName(v1proto::FrameCheck check);
 
-using alertsVectorRaw = std::vector<std::vector<uint8_t>>;
+using AlertRecord = std::array<uint8_t, 7>;   // respAlertData payload, index byte first
+using alertsVectorRaw = std::vector<AlertRecord>;
 extern std::vector<LogEntry> logHistory;
 
 class PacketDecoder {
 private:
-    const std::vector<uint8_t>& rawpacket;
+    v1proto::FrameView rawpacket;
 public:
-    PacketDecoder(const std::vector<uint8_t>& rawpacket);
+    PacketDecoder(const uint8_t *data, size_t length);
 
     void decode_v2(int lowSpeedThreshold, uint8_t currentSpeed);
     void decodeAlertData_v2(const alertsVectorRaw& alerts, int lowSpeedThreshold, uint8_t currentSpeed);
 };
 
+// Request frames, built from the schema in v1_proto.h and returned by value
 class Packet {
 public:
-    static uint8_t calculateChecksum(const uint8_t *data, size_t length);
-    static uint8_t* constructPacket(uint8_t destID, uint8_t sendID, uint8_t packetID, uint8_t *payloadData, uint8_t payloadLength, uint8_t *packet);
-    static uint8_t* reqStartAlertData();
-    static uint8_t* reqVersion();
-    static uint8_t* reqAllSweepDefinitions();
-    static uint8_t* reqSweepSections();
-    static uint8_t* reqMaxSweepIndex();
-    static uint8_t* reqSerialNumber();
-    static uint8_t* reqTurnOffMainDisplay(uint8_t mode);
-    static uint8_t* reqTurnOnMainDisplay();
-    static uint8_t* reqBatteryVoltage();
-    static uint8_t* reqMuteOff();
-    static uint8_t* reqMuteOn();
-    static uint8_t* reqChangeMode(uint8_t mode);
-    static uint8_t* reqCurrentVolume();
-    static uint8_t* reqUserBytes();
-    static uint8_t* reqSavvyStatus();
-    static uint8_t* reqVehicleSpeed();
+    static constexpr v1proto::ReqStartAlertData::Frame reqStartAlertData() { return v1proto::encode<v1proto::ReqStartAlertData>(); }
+    static constexpr v1proto::ReqVersion::Frame reqVersion() { return v1proto::encode<v1proto::ReqVersion>(); }
+    static constexpr v1proto::ReqAllSweepDefinitions::Frame reqAllSweepDefinitions() { return v1proto::encode<v1proto::ReqAllSweepDefinitions>(); }
+    static constexpr v1proto::ReqSweepSections::Frame reqSweepSections() { return v1proto::encode<v1proto::ReqSweepSections>(); }
+    static constexpr v1proto::ReqMaxSweepIndex::Frame reqMaxSweepIndex() { return v1proto::encode<v1proto::ReqMaxSweepIndex>(); }
+    static constexpr v1proto::ReqSerialNumber::Frame reqSerialNumber() { return v1proto::encode<v1proto::ReqSerialNumber>(); }
+    static constexpr v1proto::ReqTurnOffMainDisplay::Frame reqTurnOffMainDisplay(uint8_t mode) { return v1proto::encode<v1proto::ReqTurnOffMainDisplay>(mode); }
+    static constexpr v1proto::ReqTurnOnMainDisplay::Frame reqTurnOnMainDisplay() { return v1proto::encode<v1proto::ReqTurnOnMainDisplay>(); }
+    static constexpr v1proto::ReqBatteryVoltage::Frame reqBatteryVoltage() { return v1proto::encode<v1proto::ReqBatteryVoltage>(); }
+    static constexpr v1proto::ReqMuteOff::Frame reqMuteOff() { return v1proto::encode<v1proto::ReqMuteOff>(); }
+    static constexpr v1proto::ReqMuteOn::Frame reqMuteOn() { return v1proto::encode<v1proto::ReqMuteOn>(); }
+    static constexpr v1proto::ReqChangeMode::Frame reqChangeMode(uint8_t mode) { return v1proto::encode<v1proto::ReqChangeMode>(mode); }
+    static constexpr v1proto::ReqCurrentVolume::Frame reqCurrentVolume() { return v1proto::encode<v1proto::ReqCurrentVolume>(); }
+    static constexpr v1proto::ReqUserBytes::Frame reqUserBytes() { return v1proto::encode<v1proto::ReqUserBytes>(); }
+    static constexpr v1proto::ReqSavvyStatus::Frame reqSavvyStatus() { return v1proto::encode<v1proto::ReqSavvyStatus>(); }
+    static constexpr v1proto::ReqVehicleSpeed::Frame reqVehicleSpeed() { return v1proto::encode<v1proto::ReqVehicleSpeed>(); }
 };
 
 #endif // PACKETDECODER_H
\ No newline at end of file
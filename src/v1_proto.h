@@ -0,0 +1,268 @@
+#ifndef V1_PROTO_H
+#define V1_PROTO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <array>
+
+// Packet config
+#define PACKETSTART 0xAA
+#define PACKETEND 0xAB
+#define REQVERSION 0x01
+#define DEST_V1 0x0A // send packets to the v1 device id
+//#define DEST_V1_LE 0x06
+#define REMOTE_SENDER 0x06 // originate packets from 0x04 - "third party use"
+#define V1_FRAME_OVERHEAD 7 // start, dest, sender, id, length, checksum, end
+#define V1_ORIGIN_NO_CHECKSUM 0x09 // a V1 that doesn't checksum its frames; every other origin does
+
+#define PACKET_ID_REQVERSION 0x01
+#define PACKET_ID_REQSERIALNUMBER 0x03
+#define PACKET_ID_REQUSERBYTES 0x11
+#define PACKET_ID_REQALLSWEEPDEFINITIONS 0x16
+#define PACKET_ID_REQMAXSWEEPINDEX 0x19
+#define PACKET_ID_REQSWEEPSECTIONS 0x22
+#define PACKET_ID_REQTURNOFFMAINDISPLAY 0x32
+#define PACKET_ID_REQTURNONMAINDISPLAY 0x33
+#define PACKET_ID_REQMUTEON 0x34
+#define PACKET_ID_REQMUTEOFF 0x35
+#define PACKET_ID_REQCHANGEMODE 0x36
+#define PACKET_ID_REQCURRENTVOLUME 0x37
+#define PACKET_ID_REQSTARTALERTDATA 0x41
+#define PACKET_ID_REQBATTERYVOLTAGE 0x62
+#define PACKET_ID_REQSAVVYSTATUS 0x71
+#define PACKET_ID_REQVEHICLESPEED 0x73
+
+#define PACKET_ID_RESPVERSION 0x02
+#define PACKET_ID_RESPSERIALNUMBER 0x04
+#define PACKET_ID_RESPUSERBYTES 0x12
+#define PACKET_ID_RESPSWEEPDEFINITION 0x17
+#define PACKET_ID_RESPMAXSWEEPINDEX 0x20
+#define PACKET_ID_RESPSWEEPSECTIONS 0x23
+#define PACKET_ID_INFDISPLAYDATA 0x31
+#define PACKET_ID_RESPCURRENTVOLUME 0x38
+#define PACKET_ID_RESPALERTDATA 0x43
+#define PACKET_ID_RESPBATTERYVOLTAGE 0x63
+#define PACKET_ID_INFV1BUSY 0x66
+#define PACKET_ID_RESPSAVVYSTATUS 0x72
+#define PACKET_ID_RESPVEHICLESPEED 0x74
+#define PACKET_ID_NONE 0x00
+
+// V1 ESP wire format. Frames are AA, D0+dest, E0+sender, id, length, payload...,
+// checksum, AB; the length byte counts the payload plus the checksum.
+//
+// The schema below is the single description of every request we send (packet ID,
+// payload size, the response it is answered with) and every response we decode
+// (packet ID, minimum payload). encode<>() turns a request into a std::array at compile
+// time; the response structs read their fields straight out of the receive buffer.
+namespace v1proto {
+
+static constexpr uint8_t DEST_BYTE = 0xD0 + DEST_V1;
+static constexpr uint8_t SENDER_BYTE = 0xE0 + REMOTE_SENDER;
+
+template <uint8_t Id, uint8_t ResponseId, size_t PayloadLength = 0>
+struct Request {
+  static constexpr uint8_t id = Id;
+  static constexpr uint8_t responseId = ResponseId;
+  static constexpr size_t payloadLength = PayloadLength;
+  typedef std::array<uint8_t, V1_FRAME_OVERHEAD + PayloadLength> Frame;
+};
+
+typedef Request<PACKET_ID_REQVERSION,             PACKET_ID_RESPVERSION>          ReqVersion;
+typedef Request<PACKET_ID_REQSERIALNUMBER,        PACKET_ID_RESPSERIALNUMBER>     ReqSerialNumber;
+typedef Request<PACKET_ID_REQUSERBYTES,           PACKET_ID_RESPUSERBYTES>        ReqUserBytes;
+typedef Request<PACKET_ID_REQALLSWEEPDEFINITIONS, PACKET_ID_RESPSWEEPDEFINITION>  ReqAllSweepDefinitions;
+typedef Request<PACKET_ID_REQMAXSWEEPINDEX,       PACKET_ID_RESPMAXSWEEPINDEX>    ReqMaxSweepIndex;
+typedef Request<PACKET_ID_REQSWEEPSECTIONS,       PACKET_ID_RESPSWEEPSECTIONS>    ReqSweepSections;
+typedef Request<PACKET_ID_REQTURNOFFMAINDISPLAY,  PACKET_ID_NONE, 1>              ReqTurnOffMainDisplay;
+typedef Request<PACKET_ID_REQTURNONMAINDISPLAY,   PACKET_ID_NONE>                 ReqTurnOnMainDisplay;
+typedef Request<PACKET_ID_REQMUTEON,              PACKET_ID_NONE>                 ReqMuteOn;
+typedef Request<PACKET_ID_REQMUTEOFF,             PACKET_ID_NONE>                 ReqMuteOff;
+typedef Request<PACKET_ID_REQCHANGEMODE,          PACKET_ID_NONE, 1>              ReqChangeMode;
+typedef Request<PACKET_ID_REQCURRENTVOLUME,       PACKET_ID_RESPCURRENTVOLUME>    ReqCurrentVolume;
+typedef Request<PACKET_ID_REQSTARTALERTDATA,      PACKET_ID_RESPALERTDATA>        ReqStartAlertData;
+typedef Request<PACKET_ID_REQBATTERYVOLTAGE,      PACKET_ID_RESPBATTERYVOLTAGE>   ReqBatteryVoltage;
+typedef Request<PACKET_ID_REQSAVVYSTATUS,         PACKET_ID_RESPSAVVYSTATUS>      ReqSavvyStatus;
+typedef Request<PACKET_ID_REQVEHICLESPEED,        PACKET_ID_RESPVEHICLESPEED>     ReqVehicleSpeed;
+
+constexpr uint8_t checksum() { return 0; }
+
+template <typename... Bytes>
+constexpr uint8_t checksum(uint8_t first, Bytes... rest)
+{
+  return static_cast<uint8_t>(first + checksum(rest...));
+}
+
+// Runtime sum, a word at a time: each 32-bit load is split into two 16-bit lanes of two
+// bytes each, so a lane holds at most 2 * 255 per word and can't carry into its neighbour
+// before 128 words. The length byte caps a frame at 261 bytes, well inside that.
+inline uint8_t checksum(const uint8_t *data, size_t length)
+{
+  uint32_t lanes = 0;
+  size_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    uint32_t w;
+    memcpy(&w, data + i, sizeof(w));
+    lanes += (w & 0x00FF00FF) + ((w >> 8) & 0x00FF00FF);
+  }
+  uint8_t sum = static_cast<uint8_t>(lanes + (lanes >> 16));
+  for (; i < length; i++) sum += data[i];
+  return sum;
+}
+
+template <typename Req, typename... Bytes>
+constexpr typename Req::Frame encode(Bytes... payload)
+{
+  static_assert(sizeof...(Bytes) == Req::payloadLength, "payload doesn't match the request schema");
+  return typename Req::Frame{{
+    PACKETSTART, DEST_BYTE, SENDER_BYTE, Req::id, static_cast<uint8_t>(Req::payloadLength + 1),
+    static_cast<uint8_t>(payload)...,
+    checksum(PACKETSTART, DEST_BYTE, SENDER_BYTE, Req::id, static_cast<uint8_t>(Req::payloadLength + 1),
+             static_cast<uint8_t>(payload)...),
+    PACKETEND
+  }};
+}
+
+// Non-owning view of one received frame; only valid while the buffer it points to is.
+class FrameView {
+public:
+  FrameView(const uint8_t *data, size_t length) : d(data), n(length) {}
+
+  const uint8_t &operator[](size_t i) const { return d[i]; }
+  size_t size() const { return n; }
+  const uint8_t *begin() const { return d; }
+  const uint8_t *end() const { return d + n; }
+
+  uint8_t id() const { return d[3]; }
+  bool hasChecksum() const { return (d[2] & 0x0F) != V1_ORIGIN_NO_CHECKSUM; }
+  const uint8_t *payload() const { return d + 5; }
+  size_t payloadLength() const { return hasChecksum() ? (d[4] > 0 ? d[4] - 1 : 0) : d[4]; }
+
+private:
+  const uint8_t *d;
+  size_t n;
+};
+
+template <uint8_t Id, size_t MinPayload>
+struct Response {
+  static constexpr uint8_t id = Id;
+  static constexpr size_t minPayload = MinPayload;
+  explicit Response(const FrameView &frame) : p(frame.payload()), len(frame.payloadLength()) {}
+
+protected:
+  static uint16_t word(const uint8_t *b) { return (static_cast<uint16_t>(b[0]) << 8) | b[1]; }
+  const uint8_t *p;
+  size_t len;
+};
+
+struct InfDisplayData : Response<PACKET_ID_INFDISPLAYDATA, 8> {
+  using Response::Response;
+  uint8_t bandArrow1() const { return p[3]; }
+  uint8_t bandArrow2() const { return p[4]; }
+  uint8_t aux0() const { return p[5]; }
+  uint8_t aux1() const { return p[6]; }
+  uint8_t aux2() const { return p[7]; }
+};
+
+struct RespAlertData : Response<PACKET_ID_RESPALERTDATA, 7> {
+  using Response::Response;
+  uint8_t indexCount() const { return p[0]; }
+  uint8_t index() const { return p[0] >> 4; }
+  uint8_t count() const { return p[0] & 0x0F; }
+  const uint8_t *record() const { return p; }    // the 7-byte alert record, index byte first
+};
+
+struct RespVersion : Response<PACKET_ID_RESPVERSION, 7> {
+  using Response::Response;
+  uint8_t component() const { return p[0]; }    // 'V' for the V1 itself
+  const uint8_t *text() const { return p + 1; } // "x.yyyz", 6 bytes
+};
+
+struct RespSerialNumber : Response<PACKET_ID_RESPSERIALNUMBER, 10> {
+  using Response::Response;
+  const uint8_t *text() const { return p; }     // 10 bytes
+};
+
+struct RespUserBytes : Response<PACKET_ID_RESPUSERBYTES, 6> {
+  using Response::Response;
+  const uint8_t *bytes() const { return p; }
+};
+
+struct RespSweepDefinition : Response<PACKET_ID_RESPSWEEPDEFINITION, 5> {
+  using Response::Response;
+  uint8_t index() const { return p[0] & 0x3F; }
+  uint16_t upperEdge() const { return word(p + 1); }
+  uint16_t lowerEdge() const { return word(p + 3); }
+};
+
+struct RespMaxSweepIndex : Response<PACKET_ID_RESPMAXSWEEPINDEX, 1> {
+  using Response::Response;
+  uint8_t maxIndex() const { return p[0]; }
+};
+
+// Up to three sections per frame, five bytes each
+struct RespSweepSections : Response<PACKET_ID_RESPSWEEPSECTIONS, 5> {
+  using Response::Response;
+  uint8_t count() const { return len / 5 < 3 ? len / 5 : 3; }
+  uint8_t sectionIndex(uint8_t i) const { return p[i * 5] >> 4; }
+  uint16_t upperEdge(uint8_t i) const { return word(p + i * 5 + 1); }
+  uint16_t lowerEdge(uint8_t i) const { return word(p + i * 5 + 3); }
+};
+
+struct RespCurrentVolume : Response<PACKET_ID_RESPCURRENTVOLUME, 2> {
+  using Response::Response;
+  uint8_t mainVolume() const { return p[0]; }
+  uint8_t mutedVolume() const { return p[1]; }
+};
+
+struct RespBatteryVoltage : Response<PACKET_ID_RESPBATTERYVOLTAGE, 2> {
+  using Response::Response;
+  float volts() const { return p[0] + p[1] / 100.0f; }
+};
+
+struct InfV1Busy : Response<PACKET_ID_INFV1BUSY, 0> {
+  using Response::Response;
+  uint8_t pending() const { return len; }
+  uint8_t firstPending() const { return len ? p[0] : 0; }
+};
+
+// Smallest payload each decoded response may carry; anything shorter would be read past its end
+inline size_t minPayload(uint8_t id)
+{
+  switch (id) {
+    case InfDisplayData::id:      return InfDisplayData::minPayload;
+    case RespAlertData::id:       return RespAlertData::minPayload;
+    case RespVersion::id:         return RespVersion::minPayload;
+    case RespSerialNumber::id:    return RespSerialNumber::minPayload;
+    case RespUserBytes::id:       return RespUserBytes::minPayload;
+    case RespSweepDefinition::id: return RespSweepDefinition::minPayload;
+    case RespMaxSweepIndex::id:   return RespMaxSweepIndex::minPayload;
+    case RespSweepSections::id:   return RespSweepSections::minPayload;
+    case RespCurrentVolume::id:   return RespCurrentVolume::minPayload;
+    case RespBatteryVoltage::id:  return RespBatteryVoltage::minPayload;
+    default:                      return 0;
+  }
+}
+
+enum FrameCheck : uint8_t {
+  FRAME_OK = 0,
+  FRAME_BAD_FRAMING,    // too short, or missing the AA/AB markers
+  FRAME_BAD_LENGTH,     // length byte disagrees with what arrived
+  FRAME_BAD_CHECKSUM,
+  FRAME_SHORT_PAYLOAD,  // well formed, but too short for its packet ID
+  FRAME_CHECKS
+};
+
+inline FrameCheck check(const FrameView &frame)
+{
+  size_t n = frame.size();
+  if (n < V1_FRAME_OVERHEAD - 1 || frame[0] != PACKETSTART || frame[n - 1] != PACKETEND) return FRAME_BAD_FRAMING;
+  if (frame[4] + 6u != n) return FRAME_BAD_LENGTH;
+  if (frame.hasChecksum() && (frame[4] == 0 || checksum(frame.begin(), n - 2) != frame[n - 2])) return FRAME_BAD_CHECKSUM;
+  if (frame.payloadLength() < minPayload(frame.id())) return FRAME_SHORT_PAYLOAD;
+  return FRAME_OK;
+}
+
+} // namespace v1proto
+
+#endif // V1_PROTO_H
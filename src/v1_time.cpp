@@ -0,0 +1,244 @@
+#include "v1_time.h"
+#include <math.h>
+
+// Zones offered by the settings page. All DST-observing entries follow the US rule:
+// second Sunday of March to first Sunday of November, switching at 02:00 local.
+struct TzRule {
+  const char *name;
+  int32_t stdOffset;  // seconds east of UTC
+  bool usDst;
+};
+
+static const TzRule tzRules[] = {
+  { "UTC",                 0,          false },
+  { "America/New_York",    -5 * 3600,  true  },
+  { "America/Chicago",     -6 * 3600,  true  },
+  { "America/Denver",      -7 * 3600,  true  },
+  { "America/Phoenix",     -7 * 3600,  false },
+  { "America/Los_Angeles", -8 * 3600,  true  },
+  { "America/Anchorage",   -9 * 3600,  true  },
+  { "Pacific/Honolulu",    -10 * 3600, false },
+};
+
+// The offset only changes at DST transitions, so it is cached together with the
+// interval it is valid for; converting a fix is then a bounds check and an add.
+struct TzCache {
+  const TzRule *rule;
+  time_t validFrom;
+  time_t validUntil;
+  int32_t offset;
+};
+
+static portMUX_TYPE timeMux = portMUX_INITIALIZER_UNLOCKED;
+static TzCache tzCache = { &tzRules[0], 0, 0, 0 };
+static SolarDay solarCache = { -1 };
+
+static int64_t daysFromCivil(int y, int m, int d)
+{
+  y -= m <= 2;
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(y - era * 400);
+  const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+static void civilFromDays(int64_t z, int &y, int &m, int &d)
+{
+  z += 719468;
+  const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const unsigned doe = static_cast<unsigned>(z - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y = static_cast<int>(yoe + era * 400) + (m <= 2);
+}
+
+static int64_t floorDiv(int64_t a, int64_t b)
+{
+  return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+time_t makeUtcTime(int year, int month, int day, int hour, int minute, int second)
+{
+  return static_cast<time_t>(daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second);
+}
+
+void civilFromEpoch(time_t t, int &year, int &month, int &day, int &hour, int &minute, int &second)
+{
+  const int64_t days = floorDiv(t, 86400);
+  int32_t secs = static_cast<int32_t>(t - days * 86400);
+  civilFromDays(days, year, month, day);
+  hour = secs / 3600;
+  secs -= hour * 3600;
+  minute = secs / 60;
+  second = secs - minute * 60;
+}
+
+// day of month of the n-th Sunday (1-based) of the given month
+static int nthSunday(int year, int month, int n)
+{
+  const int64_t first = daysFromCivil(year, month, 1);
+  const int weekday = static_cast<int>(first + 4 - floorDiv(first + 4, 7) * 7);  // 1970-01-01 was a Thursday, 0 = Sunday
+  return 1 + (7 - weekday) % 7 + (n - 1) * 7;
+}
+
+static time_t dstStartUtc(const TzRule *rule, int year)
+{
+  return makeUtcTime(year, 3, nthSunday(year, 3, 2), 2, 0, 0) - rule->stdOffset;
+}
+
+static time_t dstEndUtc(const TzRule *rule, int year)
+{
+  return makeUtcTime(year, 11, nthSunday(year, 11, 1), 2, 0, 0) - (rule->stdOffset + 3600);
+}
+
+static TzCache computeTzCache(const TzRule *rule, time_t utc)
+{
+  TzCache c = { rule, INT32_MIN, INT32_MAX, rule->stdOffset };
+  if (!rule->usDst) return c;
+
+  int year, month, day, hour, minute, second;
+  civilFromEpoch(utc, year, month, day, hour, minute, second);
+
+  const time_t start = dstStartUtc(rule, year);
+  const time_t end = dstEndUtc(rule, year);
+
+  if (utc < start) {
+    c.validFrom = dstEndUtc(rule, year - 1);
+    c.validUntil = start;
+  } else if (utc < end) {
+    c.offset += 3600;
+    c.validFrom = start;
+    c.validUntil = end;
+  } else {
+    c.validFrom = end;
+    c.validUntil = dstStartUtc(rule, year + 1);
+  }
+  return c;
+}
+
+void setLocalTimezone(const char *tzName)
+{
+  const TzRule *rule = &tzRules[0];
+  for (const TzRule &r : tzRules) {
+    if (strcmp(r.name, tzName) == 0) {
+      rule = &r;
+      break;
+    }
+  }
+  if (rule == &tzRules[0] && strcmp(tzName, "UTC") != 0) {
+    Serial.printf("TZ: unknown timezone '%s', using UTC\n", tzName);
+  }
+
+  portENTER_CRITICAL(&timeMux);
+  tzCache.rule = rule;
+  tzCache.validFrom = 0;
+  tzCache.validUntil = 0;
+  solarCache.localDay = -1;
+  portEXIT_CRITICAL(&timeMux);
+}
+
+int32_t localOffsetAt(time_t utc)
+{
+  portENTER_CRITICAL(&timeMux);
+  const TzCache cached = tzCache;
+  portEXIT_CRITICAL(&timeMux);
+  if (utc >= cached.validFrom && utc < cached.validUntil) return cached.offset;
+
+  const TzCache fresh = computeTzCache(cached.rule, utc);
+  portENTER_CRITICAL(&timeMux);
+  if (tzCache.rule == fresh.rule) tzCache = fresh;
+  portEXIT_CRITICAL(&timeMux);
+
+  Serial.printf("TZ: %s offset %ld s until %ld\n", fresh.rule->name, (long)fresh.offset, (long)fresh.validUntil);
+  return fresh.offset;
+}
+
+time_t utcToLocal(time_t utc)
+{
+  return utc + localOffsetAt(utc);
+}
+
+static inline double julianToEpoch(double jd)
+{
+  return (jd - 2440587.5) * 86400.0;
+}
+
+// Sunrise equation (NOAA approximation), good to about a minute at mid latitudes.
+static void computeSolarDay(int32_t localDay, double latitude, double longitude, SolarDay &out)
+{
+  const double DEG = M_PI / 180.0;
+  const double n = static_cast<double>(localDay - 10957);  // days since J2000.0 at local noon
+  const double jStar = n - longitude / 360.0;
+  const double M = fmod(357.5291 + 0.98560028 * jStar, 360.0);
+  const double C = 1.9148 * sin(M * DEG) + 0.0200 * sin(2 * M * DEG) + 0.0003 * sin(3 * M * DEG);
+  const double lambda = fmod(M + C + 180.0 + 102.9372, 360.0);
+  const double jTransit = 2451545.0 + jStar + 0.0053 * sin(M * DEG) - 0.0069 * sin(2 * lambda * DEG);
+  const double sinDecl = sin(lambda * DEG) * sin(23.4397 * DEG);
+  const double cosDecl = cos(asin(sinDecl));
+  const double sinLat = sin(latitude * DEG);
+  const double cosLat = cos(latitude * DEG);
+
+  auto hourAngle = [&](double elevation, bool &up, bool &down) {
+    double cosH = (sin(elevation * DEG) - sinLat * sinDecl) / (cosLat * cosDecl);
+    up = cosH < -1.0;
+    down = cosH > 1.0;
+    return (up || down) ? 0.0 : acos(cosH) / DEG;
+  };
+
+  bool up, down, civilUp, civilDown;
+  const double h0 = hourAngle(-0.833, up, down);
+  const double h6 = hourAngle(-6.0, civilUp, civilDown);
+
+  out.localDay = localDay;
+  out.latitude = latitude;
+  out.longitude = longitude;
+  out.alwaysUp = up;
+  out.alwaysDown = down;
+  out.solarNoon = static_cast<time_t>(julianToEpoch(jTransit));
+  out.sunrise = static_cast<time_t>(julianToEpoch(jTransit - h0 / 360.0));
+  out.sunset = static_cast<time_t>(julianToEpoch(jTransit + h0 / 360.0));
+  if (civilDown) {
+    out.civilDawn = out.sunrise;
+    out.civilDusk = out.sunset;
+  } else if (civilUp) {
+    // the sun never gets to -6 degrees, so twilight lasts all night: ramp from solar midnight
+    out.civilDawn = static_cast<time_t>(julianToEpoch(jTransit - 0.5));
+    out.civilDusk = static_cast<time_t>(julianToEpoch(jTransit + 0.5));
+  } else {
+    out.civilDawn = static_cast<time_t>(julianToEpoch(jTransit - h6 / 360.0));
+    out.civilDusk = static_cast<time_t>(julianToEpoch(jTransit + h6 / 360.0));
+  }
+}
+
+// Returns the cached table for the local day containing utc, recomputing it only on
+// local date rollover or after a move of more than half a degree.
+bool getSolarDay(time_t utc, double latitude, double longitude, SolarDay &out)
+{
+  if (latitude == 0.0 && longitude == 0.0) return false;
+
+  const int32_t localDay = static_cast<int32_t>(floorDiv(utcToLocal(utc), 86400));
+
+  portENTER_CRITICAL(&timeMux);
+  bool hit = solarCache.localDay == localDay &&
+             fabsf(solarCache.latitude - latitude) < 0.5f &&
+             fabsf(solarCache.longitude - longitude) < 0.5f;
+  if (hit) out = solarCache;
+  portEXIT_CRITICAL(&timeMux);
+  if (hit) return true;
+
+  SolarDay fresh;
+  computeSolarDay(localDay, latitude, longitude, fresh);
+
+  portENTER_CRITICAL(&timeMux);
+  solarCache = fresh;
+  portEXIT_CRITICAL(&timeMux);
+
+  Serial.printf("SOLAR: day %ld dawn %ld rise %ld set %ld dusk %ld\n", (long)localDay,
+                (long)fresh.civilDawn, (long)fresh.sunrise, (long)fresh.sunset, (long)fresh.civilDusk);
+  out = fresh;
+  return true;
+}
@@ -0,0 +1,31 @@
+#ifndef V1_TIME_H
+#define V1_TIME_H
+
+#include <Arduino.h>
+#include <time.h>
+
+// Sun events for one local calendar day, all as UTC epoch seconds.
+// Polar days/nights are flagged instead of given event times.
+struct SolarDay {
+  int32_t localDay;       // days since 1970-01-01 in local time, -1 = not computed
+  time_t civilDawn;
+  time_t sunrise;
+  time_t solarNoon;
+  time_t sunset;
+  time_t civilDusk;
+  bool alwaysUp;
+  bool alwaysDown;
+  float latitude;
+  float longitude;
+};
+
+void setLocalTimezone(const char *tzName);
+int32_t localOffsetAt(time_t utc);
+time_t utcToLocal(time_t utc);
+
+time_t makeUtcTime(int year, int month, int day, int hour, int minute, int second);
+void civilFromEpoch(time_t t, int &year, int &month, int &day, int &hour, int &minute, int &second);
+
+bool getSolarDay(time_t utc, double latitude, double longitude, SolarDay &out);
+
+#endif // V1_TIME_H
@@ -16,6 +16,12 @@
 #include <ui/ui.h>
 #include "utils.h"
 #include "gps.h"
+#include "v1_time.h"
+#include "brightness.h"
+#include "ui_task.h"
+#include "touch.h"
+#include "v1_handshake.h"
+#include "v1_cache.h"
 #include "esp_flash.h"
 
 AsyncWebServer server(80);
@@ -38,8 +44,6 @@ int loopCounter = 0;
 unsigned long bootMillis = 0;
 unsigned long lastMillis = 0;
 unsigned long lastWifiReconnect = 0;
-const unsigned long uiTickInterval = 16;
-const unsigned long atTickInterval = 250;
 
 QueueHandle_t radarQueue;
 
@@ -60,6 +64,9 @@ void loadLockoutSettings() {
 void loadSettings() {
   preferences.begin("settings", false);
   settings.brightness = preferences.getUInt("brightness", amoled.getBrightness());
+  settings.autoBrightness = preferences.getBool("autoBright", false);
+  uint32_t nightBrightness = preferences.getUInt("nightBright", 40);
+  settings.nightBrightness = nightBrightness >= NIGHT_BRIGHTNESS_MIN && nightBrightness <= 255 ? nightBrightness : 40;
 
   int mode = preferences.getInt("wifiMode", WIFI_MODE_STA);
   if (mode < WIFI_MODE_AP || mode > WIFI_MODE_APSTA) {
@@ -71,6 +78,7 @@ void loadSettings() {
   settings.localPW = preferences.getString("localPW", "password123");
   settings.disableBLE = preferences.getBool("disableBLE", false);
   settings.proxyBLE = preferences.getBool("proxyBLE", true);
+  settings.proxyBatch = preferences.getBool("proxyBatch", false);
   settings.useV1LE = preferences.getBool("useV1LE", false);
   settings.displayTest = preferences.getBool("displayTest", false);
   settings.enableGPS = preferences.getBool("enableGPS", false);
@@ -84,7 +92,10 @@ void loadSettings() {
     settings.unitSystem = IMPERIAL;
   }
   settings.displayOrientation = preferences.getInt("displayOrient", 0);
+  uint32_t bufferMode = preferences.getUInt("dispBufMode", LVGL_BUFFER_AUTO);
+  settings.displayBufferMode = bufferMode <= LVGL_BUFFER_PSRAM_FULL ? bufferMode : LVGL_BUFFER_AUTO;
   settings.timezone = preferences.getString("timezone", "UTC");
+  setLocalTimezone(settings.timezone.c_str());
   settings.muteToGray = preferences.getBool("muteToGray", false);
   settings.colorBars = preferences.getBool("colorBars", true);
   settings.showBogeyCount = preferences.getBool("showBogeys", false);
@@ -169,13 +180,20 @@ void setup()
 
   Serial.printf("Free heap after board init: %u\n", ESP.getFreeHeap());
 
-  beginLvglHelperDMA(amoled);
+  beginLvglHelperDMA(amoled, false, settings.displayBufferMode);
   Serial.printf("Setup running on core %d\n", xPortGetCoreID());
   Serial.printf("Free heap after LVGL init: %u\n", ESP.getFreeHeap());
 
   ui_init();
   ui_tick();
   lv_task_handler();
+  initAutoBrightness();
+
+  // started before any early exit below, so the display keeps running if storage fails
+  startTouchReader(amoled);
+
+  // from here on LVGL belongs to the UI task
+  startUiTask();
 
   if (!initStorage()) {
     Serial.println("Failed to initialize LittleFS");
@@ -207,11 +225,6 @@ void setup()
     xTaskCreatePinnedToCore(gpsTask, "GPSTask", 3072, NULL, 1, NULL, 1);
   }
 
-  lv_obj_t * scr = lv_scr_act();
-  if (scr) {
-    lv_obj_add_event_cb(scr, main_press_handler, LV_EVENT_ALL, NULL);
-  }
-  
   bootDeviceStats();
   stats.totalStorageKB = fileManager.getStorageTotal();
   stats.usedStorageKB = fileManager.getStorageUsed();
@@ -233,70 +246,23 @@ void loop() {
   // unsigned long loopStart = millis();
   // unsigned long now = loopStart;
   
-  static bool configHasRun = false;
-  static unsigned long lastTick = 0;
-  static unsigned long lastTableTick = 0;
-  
+  // BLE handshake and housekeeping worker; LVGL runs in the UI task (ui_task.cpp)
   if (bt_connected && bleInit) {
+    v1CacheLoad();
     displayReader(pClient);
     bleInit = false;
 
     unsigned long elapsedMillis = millis() - bootMillis;
     Serial.printf("processing packets at: %.2f seconds\n", elapsedMillis / 1000.0);
+    handshakeStart();
   }
+  handshakeTick();
 
   unsigned long currentMillis = millis();
   if (currentMillis - lastMillis >= 2000) {
     //Serial.printf("Uptime: %u | Loops executed: %d\n", stats.uptime, loopCounter); // uncomment for loop profiling
     getDeviceStats();
 
-    // This will obtain the User-defined settings (eg. disabling certain bands)
-    if (!configHasRun && !settings.displayTest) {
-      if (bt_connected && clientWriteCharacteristic) {
-        if (!serialReceived) {
-          Serial.println("Awaiting Serial Number...");
-          requestSerialNumber();
-        }
-        if (!versionReceived) {
-          Serial.println("Awaiting Version...");
-          requestVersion();
-        }
-        if (!volumeReceived) {
-          Serial.println("Awaiting Volume Settings...");
-          requestVolume();
-        }
-        if (!userBytesReceived) {
-          Serial.println("Awaiting User Bytes...");
-          requestUserBytes();
-        }
-      }
-    }
-
-    if (serialReceived && versionReceived && volumeReceived && userBytesReceived) {
-      Serial.println("All device information received!");
-      configHasRun = true;
-      set_var_prio_alert_freq("");
-
-      if (!v1le) {
-        queryDeviceInfo(pClient);
-      }
-  
-      serialReceived = false;
-      versionReceived = false;
-      volumeReceived = false;
-      userBytesReceived = false;
-    }
-    
-    if (!sweepSectionsReceived && !manufacturerName.empty()) {
-      requestSweepSections();
-    }
-    if (!maxSweepIndexReceived && sweepSectionsReceived) {
-      requestMaxSweepIndex();
-    }
-    if (!allSweepDefinitionsReceived && maxSweepIndexReceived) {
-      requestAllSweepDefinitions();
-    }
-
     lastMillis = currentMillis;
     loopCounter = 0;
     checkReboot();
@@ -315,23 +281,8 @@ void loop() {
     }
   }
 
-  unsigned long now = millis();
-
-  // TODO: move this to a task
-  if (now - lastTableTick >= atTickInterval) {
-    lastTableTick = now;
-    tick_alertTable();
-  }
-
-  if (now - lastTick >= uiTickInterval) {    
-    lastTick = now;
-    ui_tick();
-    lv_task_handler();
-    unsigned long elapsedHandler = millis() - now;
-    if (elapsedHandler > 16) {
-      Serial.printf("Warning: screen draw time: %u ms\n", elapsedHandler);
-    }
-  }
-
   loopCounter++;
+
+  // nothing here is frame-critical any more; leave the core to the UI task
+  vTaskDelay(pdMS_TO_TICKS(5));
 }
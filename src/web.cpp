@@ -11,6 +11,16 @@
 #include "ui/actions.h"
 #include "ui/ui.h"
 #include "v1_fs.h"
+#include "v1_time.h"
+#include "brightness.h"
+#include "ui_task.h"
+#include "touch.h"
+#include "proxy.h"
+#include "v1_cmd.h"
+#include "v1_handshake.h"
+#include "v1_cache.h"
+#include "v1_link.h"
+#include "LV_Helper.h"
 #include "LittleFS.h"
 #include "esp_task_wdt.h"
 
@@ -67,6 +77,7 @@ LockoutEntry savedLockoutLocations[] = {
 };
 
 unsigned long rebootTime = 0;
+volatile bool displayBenchmarkRequested = false;
 bool isRebootPending, usingBattery;
 float batteryPercentage = 0.0f;
 float voltageInMv = 0.0f;
@@ -251,9 +262,7 @@ void serveCachedStaticFile(AsyncWebServer &server, const char *path, const char
 void checkReboot() {
     if (isRebootPending && millis() - rebootTime >= 3000) {
         Serial.println("Rebooting...");
-        show_popup("Rebooting...");
-        ui_tick();
-        lv_task_handler();
+        requestPopup("Rebooting...");
         delay(3000);
         ESP.restart();
     }
@@ -459,6 +468,137 @@ void handleStatusRequest(AsyncWebServerRequest *request) {
             jsonDoc["batteryCharging"] = "(charging)";
         }
         jsonDoc["carVoltage"] = stats.voltage;
+        jsonDoc["displayBuffer"] = getLvglBufferModeName();
+        if (stats.displayFps > 0) {
+            jsonDoc["displayFps"] = stats.displayFps;
+        }
+
+        FrameStats frames;
+        getFrameStats(frames);
+        JsonObject frameJson = jsonDoc.createNestedObject("uiFrames");
+        frameJson["count"] = frames.frames;
+        frameJson["overBudget"] = frames.overruns;
+        frameJson["maxMs"] = frames.maxMs;
+        JsonArray histJson = frameJson.createNestedArray("histogram");
+        for (uint8_t i = 0; i < UI_FRAME_HIST_BUCKETS; i++) {
+            JsonObject bucket = histJson.createNestedObject();
+            if (i < UI_FRAME_HIST_BUCKETS - 1) bucket["ltMs"] = uiFrameHistEdges[i];
+            bucket["frames"] = frames.hist[i];
+        }
+
+        TouchStats touch;
+        getTouchStats(touch);
+        JsonObject touchJson = jsonDoc.createNestedObject("touch");
+        touchJson["events"] = touch.events;
+        touchJson["dropped"] = touch.dropped;
+        touchJson["maxDispatchUs"] = touch.maxDispatchUs;
+        touchJson["mutes"] = touch.mutes;
+        touchJson["lastMuteUs"] = touch.lastMuteUs;
+        touchJson["maxMuteUs"] = touch.maxMuteUs;
+
+        HandshakeStats handshake;
+        getHandshakeStats(handshake);
+        JsonObject handshakeJson = jsonDoc.createNestedObject("handshake");
+        handshakeJson["complete"] = handshake.complete;
+        handshakeJson["bootCompleteMs"] = handshake.bootCompleteMs;
+        handshakeJson["retries"] = handshake.retries;
+        handshakeJson["failed"] = handshake.failed;
+        handshakeJson["configCache"] = getV1CacheStateName();
+
+        V1LinkStats v1Link;
+        getV1LinkStats(v1Link);
+        JsonObject v1LinkJson = jsonDoc.createNestedObject("v1Link");
+        if (v1Link.known) v1LinkJson["address"] = v1Link.address;
+        v1LinkJson["method"] = getV1ConnectMethodName(v1Link.lastMethod);
+        v1LinkJson["reconnectMs"] = v1Link.lastReconnectMs;
+        v1LinkJson["maxReconnectMs"] = v1Link.maxReconnectMs;
+        v1LinkJson["connects"] = v1Link.connects;
+        v1LinkJson["directFailures"] = v1Link.directFailures;
+        v1LinkJson["scans"] = v1Link.scans;
+        v1LinkJson["mtu"] = v1Link.mtu;
+        v1LinkJson["connMode"] = getV1ConnModeName(v1Link.connMode);
+        for (uint8_t m = 0; m < V1_CONN_MODES; m++) {
+            const V1ConnModeStats &mode = v1Link.modes[m];
+            JsonObject modeJson = v1LinkJson.createNestedObject(getV1ConnModeName((V1ConnMode)m));
+            float intervalMs = mode.interval * 1.25f;
+            modeJson["timeMs"] = mode.timeMs;
+            modeJson["switches"] = mode.switches;
+            modeJson["rejected"] = mode.rejected;
+            modeJson["lastSwitchMs"] = mode.lastSwitchMs;
+            modeJson["maxSwitchMs"] = mode.maxSwitchMs;
+            modeJson["intervalMs"] = intervalMs;
+            modeJson["latency"] = mode.latency;
+            if (mode.interval) {
+                // connection events per second stand in for radio power; with peripheral
+                // latency the V1 listens only every (latency + 1) events, which bounds
+                // how long a write to it can wait
+                modeJson["eventsPerSec"] = 1000.0f / intervalMs;
+                modeJson["v1EventsPerSec"] = 1000.0f / (intervalMs * (mode.latency + 1));
+                modeJson["maxWriteDelayMs"] = intervalMs * (mode.latency + 1);
+            }
+        }
+
+        V1RxStats rx;
+        getV1RxStats(rx);
+        JsonObject rxJson = jsonDoc.createNestedObject("v1Rx");
+        uint32_t rxFrames = rx.accepted;
+        rxJson["accepted"] = rx.accepted;
+        for (uint8_t c = v1proto::FRAME_OK + 1; c < v1proto::FRAME_CHECKS; c++) {
+            rxJson[getFrameCheckName((v1proto::FrameCheck)c)] = rx.rejected[c];
+            rxFrames += rx.rejected[c];
+        }
+        uint32_t cpuMHz = ESP.getCpuFreqMHz();
+        if (rxFrames) rxJson["avgCheckNs"] = (uint32_t)(rx.checkCycles * 1000 / cpuMHz / rxFrames);
+        rxJson["maxCheckNs"] = rx.maxCheckCycles * 1000 / cpuMHz;
+        JsonArray rejectsJson = rxJson.createNestedArray("rejectsById");
+        for (uint16_t id = 0; id < 256; id++) {
+            if (!rx.rejectsById[id]) continue;
+            JsonObject idJson = rejectsJson.createNestedObject();
+            idJson["id"] = id;
+            idJson["rejects"] = rx.rejectsById[id];
+        }
+
+        V1CmdStats cmds;
+        getV1CmdStats(cmds);
+        static const char *cmdClassNames[V1_CMD_PRIORITIES] = { "mute", "user", "poll" };
+        JsonObject cmdJson = jsonDoc.createNestedObject("v1Commands");
+        for (uint8_t p = 0; p < V1_CMD_PRIORITIES; p++) {
+            JsonObject classJson = cmdJson.createNestedObject(cmdClassNames[p]);
+            classJson["sent"] = cmds.sent[p];
+            classJson["maxWaitUs"] = cmds.maxWaitUs[p];
+        }
+        cmdJson["coalesced"] = cmds.coalesced;
+        cmdJson["rejected"] = cmds.rejected;
+        cmdJson["invalid"] = cmds.invalid;
+        cmdJson["flushed"] = cmds.flushed;
+        cmdJson["failed"] = cmds.failed;
+        cmdJson["busyBackoffs"] = cmds.busyBackoffs;
+
+        if (settings.proxyBLE) {
+            ProxyLinkStats links[PROXY_MAX_CLIENTS];
+            uint8_t linkCount = getProxyStats(links, PROXY_MAX_CLIENTS);
+            JsonArray proxyJson = jsonDoc.createNestedArray("proxyClients");
+            for (uint8_t i = 0; i < linkCount; i++) {
+                const ProxyLinkStats &link = links[i];
+                JsonObject linkJson = proxyJson.createNestedObject();
+                linkJson["conn"] = link.connHandle;
+                linkJson["subscribed"] = link.subscribed;
+                linkJson["forwarded"] = link.forwarded;
+                linkJson["queued"] = link.queued;
+                linkJson["dropped"] = link.dropped;
+                linkJson["lastUs"] = link.lastUs;
+                linkJson["maxUs"] = link.maxUs;
+                linkJson["avgUs"] = link.forwarded ? (uint32_t)(link.totalUs / link.forwarded) : 0;
+                linkJson["commands"] = link.commands;
+                linkJson["commandsRejected"] = link.commandsRejected;
+                linkJson["mtu"] = link.mtu;
+                linkJson["batching"] = link.batching;
+                if (link.batches) {
+                    linkJson["batches"] = link.batches;
+                    linkJson["framesPerBatch"] = (float)link.batchedFrames / link.batches;
+                }
+            }
+        }
 
         String jsonResponse;
         serializeJson(jsonDoc, jsonResponse);
@@ -600,6 +740,12 @@ void setupWebServer()
         request->send(200, "application/json", jsonResponse); 
     });
     
+    server.on("/api/benchmark", HTTP_GET, [](AsyncWebServerRequest *request) {
+        // runs on the UI task; the result shows as a popup and on /api/status
+        displayBenchmarkRequested = true;
+        request->send(200, "application/json", "{\"message\": \"Display benchmark started\"}");
+    });
+
     server.on("/stats", HTTP_GET, handleStatusRequest);
     server.on("/api/status", HTTP_GET, handleStatusRequest);
     server.on("/board-info", HTTP_GET, [](AsyncWebServerRequest *request) {
@@ -671,17 +817,21 @@ void setupWebServer()
         
         JsonObject displaySettingsJson = jsonDoc.createNestedObject("displaySettings");
         displaySettingsJson["brightness"] = settings.brightness;
+        displaySettingsJson["autoBrightness"] = settings.autoBrightness;
+        displaySettingsJson["nightBrightness"] = settings.nightBrightness;
         displaySettingsJson["wifiMode"] = settings.wifiMode;
         displaySettingsJson["localSSID"] = settings.localSSID;
         displaySettingsJson["localPW"] = settings.localPW;
         displaySettingsJson["disableBLE"] = settings.disableBLE;
         displaySettingsJson["proxyBLE"] = settings.proxyBLE;
+        displaySettingsJson["proxyBatch"] = settings.proxyBatch;
         displaySettingsJson["useV1LE"] = settings.useV1LE;
         displaySettingsJson["timezone"] = settings.timezone;
         displaySettingsJson["enableGPS"] = settings.enableGPS;
         displaySettingsJson["enableWifi"] = settings.enableWifi;
         displaySettingsJson["lowSpeedThreshold"] = settings.lowSpeedThreshold;
         displaySettingsJson["displayOrientation"] = settings.displayOrientation;
+        displaySettingsJson["displayBufferMode"] = settings.displayBufferMode;
         displaySettingsJson["isPortraitMode"] = settings.isPortraitMode;
         displaySettingsJson["useDefaultV1Mode"] = settings.useDefaultV1Mode;
         displaySettingsJson["turnOffDisplay"] = settings.turnOffDisplay;
@@ -828,6 +978,20 @@ void setupWebServer()
                 request->send(400, "application/json", "{\"error\": \"Failed to parse JSON\"}");
                 return;
             }
+            // an out-of-range mode would be persisted and leave the display without draw buffers on every boot
+            if (doc.containsKey("displayBufferMode") &&
+                (!doc["displayBufferMode"].is<unsigned int>() || doc["displayBufferMode"].as<unsigned int>() > LVGL_BUFFER_PSRAM_FULL)) {
+                Serial.println("Invalid displayBufferMode");
+                request->send(400, "application/json", "{\"error\": \"Invalid displayBufferMode\"}");
+                return;
+            }
+            if (doc.containsKey("nightBrightness") &&
+                (!doc["nightBrightness"].is<unsigned int>() ||
+                 doc["nightBrightness"].as<unsigned int>() < NIGHT_BRIGHTNESS_MIN || doc["nightBrightness"].as<unsigned int>() > 255)) {
+                Serial.println("Invalid nightBrightness");
+                request->send(400, "application/json", "{\"error\": \"Invalid nightBrightness\"}");
+                return;
+            }
             preferences.begin("settings", false);
 
             Serial.println("Settings updated:");
@@ -835,7 +999,18 @@ void setupWebServer()
                 settings.brightness = doc["brightness"].as<u8_t>();
                 Serial.println("brightness: " + String(settings.brightness));
                 preferences.putUInt("brightness", settings.brightness);
-                amoled.setBrightness(settings.brightness);
+                requestBrightness(settings.brightness);
+            }
+            if (doc.containsKey("autoBrightness")) {
+                settings.autoBrightness = doc["autoBrightness"].as<bool>();
+                Serial.println("autoBrightness: " + String(settings.autoBrightness));
+                preferences.putBool("autoBright", settings.autoBrightness);
+                if (!settings.autoBrightness) requestBrightness(settings.brightness);
+            }
+            if (doc.containsKey("nightBrightness")) {
+                settings.nightBrightness = doc["nightBrightness"].as<u8_t>();
+                Serial.println("nightBrightness: " + String(settings.nightBrightness));
+                preferences.putUInt("nightBright", settings.nightBrightness);
             }
             if (doc.containsKey("wifiMode")) {
                 int mode = doc["wifiMode"].as<int>();
@@ -911,6 +1086,11 @@ void setupWebServer()
                 Serial.println("proxyBLE: " + String(settings.proxyBLE));
                 preferences.putBool("proxyBLE", settings.proxyBLE);
             }
+            if (doc.containsKey("proxyBatch")) {
+                settings.proxyBatch = doc["proxyBatch"].as<bool>();
+                Serial.println("proxyBatch: " + String(settings.proxyBatch));
+                preferences.putBool("proxyBatch", settings.proxyBatch);
+            }
             if (doc.containsKey("useV1LE")) {
                 settings.useV1LE = doc["useV1LE"].as<bool>();
                 Serial.println("useV1LE: " + String(settings.useV1LE));
@@ -935,6 +1115,12 @@ void setupWebServer()
                 settings.isPortraitMode = (settings.displayOrientation == 1 || settings.displayOrientation == 3);
                 isRebootPending = true;
             }
+            if (doc.containsKey("displayBufferMode")) {
+                settings.displayBufferMode = doc["displayBufferMode"].as<u8_t>();
+                Serial.println("displayBufferMode: " + String(settings.displayBufferMode));
+                preferences.putUInt("dispBufMode", settings.displayBufferMode);
+                isRebootPending = true;
+            }
             if (doc.containsKey("textColor")) {
                 settings.textColor = hexToUint32(doc["textColor"].as<String>());
                 Serial.println("textColor: " + String(settings.textColor));
@@ -955,7 +1141,7 @@ void setupWebServer()
                 settings.onlyDisplayBTIcon = doc["onlyDisplayBTIcon"].as<bool>();
                 Serial.println("onlyDisplayBTIcon: " + String(settings.onlyDisplayBTIcon));
                 preferences.putBool("onlyDispBTIcon", settings.onlyDisplayBTIcon);
-                clientWriteCharacteristic->writeValue((uint8_t*)Packet::reqTurnOffMainDisplay(static_cast<uint8_t>(settings.onlyDisplayBTIcon)), 7, false);
+                v1Send(Packet::reqTurnOffMainDisplay(static_cast<uint8_t>(settings.onlyDisplayBTIcon)), V1_CMD_USER);
             }
             if (doc.containsKey("turnOffDisplay")) {
                 settings.turnOffDisplay = doc["turnOffDisplay"].as<bool>();
@@ -991,6 +1177,7 @@ void setupWebServer()
                 settings.timezone = doc["timezone"].as<String>();
                 Serial.println("timezone: " + settings.timezone);
                 preferences.putString("timezone", settings.timezone);
+                setLocalTimezone(settings.timezone.c_str());
             }
             preferences.end();
 
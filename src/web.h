@@ -36,6 +36,7 @@ enum LogField {
 extern AsyncWebServer server;
 extern unsigned long rebootTime;
 extern bool isRebootPending;
+extern volatile bool displayBenchmarkRequested;
 extern const char *lockoutFieldNames[];
 extern const char *logFieldNames[];
 